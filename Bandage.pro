@@ -17,7 +17,7 @@
 
 QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 TARGET = Bandage
 TEMPLATE = app
@@ -35,6 +35,10 @@ SOURCES += \
     program/settings.cpp \
     program/globals.cpp \
     program/graphlayoutworker.cpp \
+    program/graphloadworker.cpp \
+    program/linereader.cpp \
+    program/fastareader.cpp \
+    program/gzipreader.cpp \
     graph/debruijnnode.cpp \
     graph/debruijnedge.cpp \
     graph/graphicsitemnode.cpp \
@@ -51,20 +55,38 @@ SOURCES += \
     ui/blastsearchdialog.cpp \
     ui/infotextwidget.cpp \
     graph/assemblygraph.cpp \
+    graph/readpositions.cpp \
+    graph/fastgparser.cpp \
+    graph/gfaparser.cpp \
+    graph/trinityparser.cpp \
+    graph/graphcache.cpp \
+    graph/sequencefile.cpp \
+    graph/packedsequence.cpp \
+    graph/reversecomplement.cpp \
+    graph/graphstatistics.cpp \
+    graph/nodecolumns.cpp \
+    graph/loghistogram.cpp \
+    graph/neighbourhoodsearch.cpp \
+    graph/debruijnnodetable.cpp \
     ui/verticalscrollarea.cpp \
     ui/myprogressdialog.cpp \
     ui/nodewidthvisualaid.cpp \
+    ui/histogramwidget.cpp \
+    ui/histogramdialog.cpp \
     ui/verticallabel.cpp
 
 HEADERS  += \
     program/settings.h \
     program/globals.h \
     program/graphlayoutworker.h \
+    program/graphloadworker.h \
+    program/linereader.h \
+    program/fastareader.h \
+    program/gzipreader.h \
     graph/debruijnnode.h \
     graph/debruijnedge.h \
     graph/graphicsitemnode.h \
     graph/graphicsitemedge.h \
-    graph/ogdfnode.h \
     ui/mainwindow.h \
     ui/graphicsviewzoom.h \
     ui/settingsdialog.h \
@@ -80,9 +102,25 @@ HEADERS  += \
     ui/blastsearchdialog.h \
     ui/infotextwidget.h \
     graph/assemblygraph.h \
+    graph/readpositions.h \
+    graph/fastgparser.h \
+    graph/gfaparser.h \
+    graph/trinityparser.h \
+    graph/graphcache.h \
+    graph/sequencefile.h \
+    graph/debruijnnodetable.h \
+    graph/objectpool.h \
+    graph/nodecolumns.h \
+    graph/packedsequence.h \
+    graph/reversecomplement.h \
+    graph/graphstatistics.h \
+    graph/loghistogram.h \
+    graph/neighbourhoodsearch.h \
     ui/verticalscrollarea.h \
     ui/myprogressdialog.h \
     ui/nodewidthvisualaid.h \
+    ui/histogramwidget.h \
+    ui/histogramdialog.h \
     ui/verticallabel.h
 
 FORMS    += \
@@ -91,9 +129,13 @@ FORMS    += \
     ui/aboutdialog.ui \
     ui/enteroneblastquerydialog.ui \
     ui/blastsearchdialog.ui \
-    ui/myprogressdialog.ui
+    ui/myprogressdialog.ui \
+    ui/histogramdialog.ui
 
 
+# zlib is used to read gzipped graph files.
+LIBS += -lz
+
 # These includes are configured assuming that the OGDF
 # directory is next to the Bandage project directory.
 unix:INCLUDEPATH += /usr/include/
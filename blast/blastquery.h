@@ -20,17 +20,18 @@
 #define BLASTQUERY_H
 
 #include <QString>
+#include <QByteArray>
 
 class BlastQuery
 {
 public:
     BlastQuery() {}
-    BlastQuery(QString name, QString sequence) : m_name(name), m_sequence(sequence),
+    BlastQuery(QString name, QByteArray sequence) : m_name(name), m_sequence(sequence),
         m_hits(0), m_searchedFor(false)
     {m_length = sequence.length();}
 
     QString m_name;
-    QString m_sequence;
+    QByteArray m_sequence;
     int m_length;
     int m_hits;
     bool m_searchedFor;
@@ -17,7 +17,6 @@
 
 
 #include "assemblygraph.h"
-#include <QMapIterator>
 #include "../program/globals.h"
 #include "../program/settings.h"
 #include <limits>
@@ -25,9 +24,25 @@
 #include "../graph/debruijnnode.h"
 #include "../graph/debruijnedge.h"
 #include "../graph/graphicsitemnode.h"
+#include "../program/linereader.h"
+#include "../program/fastareader.h"
+#include "../program/graphloadworker.h"
+#include "fastgparser.h"
+#include "gfaparser.h"
+#include "trinityparser.h"
+#include "graphcache.h"
+#include "sequencefile.h"
+#include "reversecomplement.h"
+#include "graphstatistics.h"
+#include <QtConcurrentMap>
+#include <QThread>
+#include <QHash>
+#include <QSet>
 
 AssemblyGraph::AssemblyGraph() :
-    m_trinityGraph(false), m_contiguitySearchDone(false)
+    m_graphCache(0), m_sequenceFile(0), m_lengthHistogram(GraphStatistics::makeLengthHistogram()),
+    m_coverageHistogram(GraphStatistics::makeCoverageHistogram()), m_trinityGraph(false),
+    m_contiguitySearchDone(false)
 {
     m_ogdfGraph = new ogdf::Graph();
     m_graphAttributes = new ogdf::GraphAttributes(*m_ogdfGraph, ogdf::GraphAttributes::nodeGraphics |
@@ -36,6 +51,7 @@ AssemblyGraph::AssemblyGraph() :
 
 AssemblyGraph::~AssemblyGraph()
 {
+    cleanUp();
     delete m_graphAttributes;
     delete m_ogdfGraph;
 }
@@ -43,17 +59,28 @@ AssemblyGraph::~AssemblyGraph()
 
 void AssemblyGraph::cleanUp()
 {
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
-    {
-        i.next();
-        delete i.value();
-    }
     m_deBruijnGraphNodes.clear();
-
-    for (size_t i = 0; i < m_deBruijnGraphEdges.size(); ++i)
-        delete m_deBruijnGraphEdges[i];
     m_deBruijnGraphEdges.clear();
+    m_deBruijnGraphEdgeIndex.clear();
+    m_adjacentEdges.clear();
+    m_nodeColumns.clear();
+    m_nodeCustomColours.clear();
+    m_nodeCustomLabels.clear();
+    m_nodeBlastHits.clear();
+    m_ogdfNodes.clear();
+    m_edgePool.clear();
+    m_nodePool.clear();
+
+    m_readPositions.clear();
+    std::vector<QByteArray>().swap(m_segmentNames);
+    m_segmentNumbers.clear();
+
+    //If the graph was loaded from a cache, its node sequences pointed into
+    //the cache, so it can only be closed now that the nodes are gone.
+    delete m_graphCache;
+    m_graphCache = 0;
+    delete m_sequenceFile;
+    m_sequenceFile = 0;
 
     m_contiguitySearchDone = false;
 
@@ -65,122 +92,156 @@ void AssemblyGraph::cleanUp()
 
 
 //This function makes a double edge: in one direction for the given nodes
-//and the opposite direction for their reverse complements.  It adds the
-//new edges to the vector here and to the nodes themselves.
+//and the opposite direction for their reverse complements.  These are two
+//separate edge objects, unless the edge is its own reverse complement.
+//It adds the new edges to the vector here and to the edge index.  The nodes
+//get their edges when buildEdgeAdjacency is called.
 void AssemblyGraph::createDeBruijnEdge(long long node1Number, long long node2Number)
 {
-    //Quit if any of the nodes don't exist.
-    if (!m_deBruijnGraphNodes.contains(node1Number) ||
-            !m_deBruijnGraphNodes.contains(node2Number) ||
-            !m_deBruijnGraphNodes.contains(-node1Number) ||
-            !m_deBruijnGraphNodes.contains(-node2Number))
+    //Quit if the edge already exists.  The index holds both edges of every
+    //pair, so this is all that is needed to check for duplicates.
+    QPair<long long, long long> forwardKey(node1Number, node2Number);
+    if (m_deBruijnGraphEdgeIndex.contains(forwardKey))
         return;
 
-    DeBruijnNode * node1 = m_deBruijnGraphNodes[node1Number];
-    DeBruijnNode * node2 = m_deBruijnGraphNodes[node2Number];
-    DeBruijnNode * negNode1 = m_deBruijnGraphNodes[-node1Number];
-    DeBruijnNode * negNode2 = m_deBruijnGraphNodes[-node2Number];
-
-    //Quit if the edge already exists
-    for (size_t i = 0; i < node1->m_edges.size(); ++i)
-    {
-        if (node1->m_edges[i]->m_startingNode == node1 &&
-                node1->m_edges[i]->m_endingNode == node2)
-            return;
-    }
+    //Quit if any of the nodes don't exist.
+    DeBruijnNode * node1 = m_deBruijnGraphNodes.value(node1Number, 0);
+    DeBruijnNode * node2 = m_deBruijnGraphNodes.value(node2Number, 0);
+    DeBruijnNode * negNode1 = m_deBruijnGraphNodes.value(-node1Number, 0);
+    DeBruijnNode * negNode2 = m_deBruijnGraphNodes.value(-node2Number, 0);
+    if (node1 == 0 || node2 == 0 || negNode1 == 0 || negNode2 == 0)
+        return;
 
     //Usually, an edge has a different pair, but it is possible
     //for an edge to be its own pair.
     bool isOwnPair = (node1 == negNode2 && node2 == negNode1);
 
-    DeBruijnEdge * forwardEdge = new DeBruijnEdge(node1, node2);
+    DeBruijnEdge * forwardEdge = m_edgePool.create(node1, node2);
     DeBruijnEdge * backwardEdge;
 
     if (isOwnPair)
         backwardEdge = forwardEdge;
     else
-        backwardEdge = new DeBruijnEdge(negNode2, negNode1);
+        backwardEdge = m_edgePool.create(negNode2, negNode1);
 
     forwardEdge->m_reverseComplement = backwardEdge;
     backwardEdge->m_reverseComplement = forwardEdge;
 
     m_deBruijnGraphEdges.push_back(forwardEdge);
+    m_deBruijnGraphEdgeIndex.insert(forwardKey, forwardEdge);
     if (!isOwnPair)
+    {
         m_deBruijnGraphEdges.push_back(backwardEdge);
-
-    node1->addEdge(forwardEdge);
-    node2->addEdge(forwardEdge);
-    negNode1->addEdge(backwardEdge);
-    negNode2->addEdge(backwardEdge);
+        m_deBruijnGraphEdgeIndex.insert(qMakePair(-node2Number, -node1Number), backwardEdge);
+    }
 }
 
 
 
-
-void AssemblyGraph::clearOgdfGraphAndResetNodes()
+//This function lays out every node's edges in one array, once the graph has
+//been loaded: for each node, the edges leaving it followed by the edges
+//entering it.  Path searches step through these ranges instead of filtering
+//each node's edges by direction at every step.
+//It must be called again if edges are added to the graph.
+void AssemblyGraph::buildEdgeAdjacency()
 {
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
+    int nodeCount = m_deBruijnGraphNodes.size();
+    for (int i = 0; i < nodeCount; ++i)
     {
-        i.next();
-        i.value()->resetNode();
+        DeBruijnNode * node = m_deBruijnGraphNodes.at(i);
+        node->m_outEdgeCount = 0;
+        node->m_inEdgeCount = 0;
     }
 
-    m_ogdfGraph->clear();
+    for (size_t i = 0; i < m_deBruijnGraphEdges.size(); ++i)
+    {
+        DeBruijnEdge * edge = m_deBruijnGraphEdges[i];
+        ++edge->m_startingNode->m_outEdgeCount;
+        ++edge->m_endingNode->m_inEdgeCount;
+    }
+
+    //Each edge is in the array twice: once for each of its nodes (or twice
+    //for the same node, if it is a loop).
+    m_adjacentEdges.assign(m_deBruijnGraphEdges.size() * 2, 0);
+    DeBruijnEdge ** nextFree = m_adjacentEdges.data();
+    for (int i = 0; i < nodeCount; ++i)
+    {
+        DeBruijnNode * node = m_deBruijnGraphNodes.at(i);
+        node->m_adjacentEdges = nextFree;
+        nextFree += node->m_outEdgeCount + node->m_inEdgeCount;
+
+        //The counts are built back up as the edges are put in place.
+        node->m_outEdgeCount = 0;
+        node->m_inEdgeCount = 0;
+    }
+
+    //The outgoing edges are put in place first, as the incoming edges'
+    //range starts after them.
+    for (size_t i = 0; i < m_deBruijnGraphEdges.size(); ++i)
+    {
+        DeBruijnEdge * edge = m_deBruijnGraphEdges[i];
+        DeBruijnNode * node = edge->m_startingNode;
+        node->m_adjacentEdges[node->m_outEdgeCount++] = edge;
+    }
+    for (size_t i = 0; i < m_deBruijnGraphEdges.size(); ++i)
+    {
+        DeBruijnEdge * edge = m_deBruijnGraphEdges[i];
+        DeBruijnNode * node = edge->m_endingNode;
+        node->m_adjacentEdges[node->m_outEdgeCount + node->m_inEdgeCount++] = edge;
+    }
 }
 
 
+//This function copies the nodes' hot attributes into the graph's columns,
+//once the graph has been loaded.  Each node is given its index in the
+//columns, so its setters can keep the drawn and contiguity columns up to
+//date.
+void AssemblyGraph::buildNodeColumns()
+{
+    int nodeCount = m_deBruijnGraphNodes.size();
+    m_nodeColumns.m_number.resize(nodeCount);
+    m_nodeColumns.m_length.resize(nodeCount);
+    m_nodeColumns.m_coverage.resize(nodeCount);
+    m_nodeColumns.m_drawn.assign(nodeCount, false);
+    m_nodeColumns.m_contiguityStatus.resize(nodeCount);
+
+    for (int i = 0; i < nodeCount; ++i)
+    {
+        DeBruijnNode * node = m_deBruijnGraphNodes.at(i);
+        m_nodeColumns.m_number[i] = node->m_number;
+        m_nodeColumns.m_length[i] = node->m_length;
+        m_nodeColumns.m_coverage[i] = node->m_coverage;
+        m_nodeColumns.m_contiguityStatus[i] = node->m_contiguityStatus;
+        node->m_columnIndex = i;
+        m_nodeColumns.setDrawn(i, node->m_drawn);
+    }
+}
 
 
 
 
-//http://www.code10.info/index.php?option=com_content&view=article&id=62:articledna-reverse-complement&catid=49:cat_coding_algorithms_bioinformatics&Itemid=74
-QByteArray AssemblyGraph::getReverseComplement(QByteArray forwardSequence)
+void AssemblyGraph::clearOgdfGraphAndResetNodes()
 {
-    QByteArray reverseComplement;
+    for (int i = 0; i < m_deBruijnGraphNodes.size(); ++i)
+        m_deBruijnGraphNodes.at(i)->resetNode();
+    m_ogdfNodes.clear();
 
-    for (int i = forwardSequence.length() - 1; i >= 0; --i)
-    {
-        char letter = forwardSequence.at(i);
+    m_ogdfGraph->clear();
+}
 
-        switch (letter)
-        {
-        case 'A': reverseComplement.append('T'); break;
-        case 'T': reverseComplement.append('A'); break;
-        case 'G': reverseComplement.append('C'); break;
-        case 'C': reverseComplement.append('G'); break;
-        case 'a': reverseComplement.append('t'); break;
-        case 't': reverseComplement.append('a'); break;
-        case 'g': reverseComplement.append('c'); break;
-        case 'c': reverseComplement.append('g'); break;
-        case 'R': reverseComplement.append('Y'); break;
-        case 'Y': reverseComplement.append('R'); break;
-        case 'S': reverseComplement.append('S'); break;
-        case 'W': reverseComplement.append('W'); break;
-        case 'K': reverseComplement.append('M'); break;
-        case 'M': reverseComplement.append('K'); break;
-        case 'r': reverseComplement.append('y'); break;
-        case 'y': reverseComplement.append('r'); break;
-        case 's': reverseComplement.append('s'); break;
-        case 'w': reverseComplement.append('w'); break;
-        case 'k': reverseComplement.append('m'); break;
-        case 'm': reverseComplement.append('k'); break;
-        case 'B': reverseComplement.append('V'); break;
-        case 'D': reverseComplement.append('H'); break;
-        case 'H': reverseComplement.append('D'); break;
-        case 'V': reverseComplement.append('B'); break;
-        case 'b': reverseComplement.append('v'); break;
-        case 'd': reverseComplement.append('h'); break;
-        case 'h': reverseComplement.append('d'); break;
-        case 'v': reverseComplement.append('b'); break;
-        case 'N': reverseComplement.append('N'); break;
-        case 'n': reverseComplement.append('n'); break;
-        case '.': reverseComplement.append('.'); break;
-        case '-': reverseComplement.append('-'); break;
-        case '?': reverseComplement.append('?'); break;
-        }
-    }
 
+
+
+
+
+//The output is made at its full size up front, and then filled by a kernel
+//which uses vector instructions where the CPU has them.
+QByteArray AssemblyGraph::getReverseComplement(QByteArray forwardSequence)
+{
+    QByteArray reverseComplement(forwardSequence.length(), Qt::Uninitialized);
+    int length = reverseComplementSequence(forwardSequence.constData(), forwardSequence.length(),
+                                           reverseComplement.data());
+    reverseComplement.resize(length);
     return reverseComplement;
 }
 
@@ -194,25 +255,24 @@ void AssemblyGraph::resetEdges()
 }
 
 
+//The drawn nodes' totals are kept up to date as nodes are drawn, so only the
+//whole graph needs a scan.
 double AssemblyGraph::getMeanDeBruijnGraphCoverage(bool drawnNodesOnly)
 {
-    int nodeCount = 0;
+    if (drawnNodesOnly)
+        return m_nodeColumns.getMeanDrawnCoverageByLength();
+
+    const int * lengths = m_nodeColumns.m_length.data();
+    const double * coverages = m_nodeColumns.m_coverage.data();
+    int nodeCount = m_nodeColumns.size();
+
     long double coverageSum = 0.0;
     long long totalLength = 0;
 
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
+    for (int i = 0; i < nodeCount; ++i)
     {
-        i.next();
-        DeBruijnNode * node = i.value();
-
-        if (drawnNodesOnly && !node->m_drawn)
-            continue;
-
-        ++nodeCount;
-        totalLength += node->m_length;
-        coverageSum += node->m_length * node->m_coverage;
-
+        totalLength += lengths[i];
+        coverageSum += lengths[i] * coverages[i];
     }
 
     if (totalLength == 0)
@@ -223,84 +283,132 @@ double AssemblyGraph::getMeanDeBruijnGraphCoverage(bool drawnNodesOnly)
 
 double AssemblyGraph::getMaxDeBruijnGraphCoverageOfDrawnNodes()
 {
-    double maxCoverage = 1.0;
-
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
-    {
-        i.next();
-
-        if (i.value()->m_graphicsItemNode != 0 && i.value()->m_coverage > maxCoverage)
-            maxCoverage = i.value()->m_coverage;
-    }
-
-    return maxCoverage;
+    return std::max(1.0, m_nodeColumns.getMaxDrawnCoverage());
 }
 
 
 void AssemblyGraph::resetNodeContiguityStatus()
 {
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
-    {
-        i.next();
-        i.value()->m_contiguityStatus = NOT_CONTIGUOUS;
-    }
+    for (int i = 0; i < m_deBruijnGraphNodes.size(); ++i)
+        m_deBruijnGraphNodes.at(i)->m_contiguityStatus = NOT_CONTIGUOUS;
+    std::fill(m_nodeColumns.m_contiguityStatus.begin(), m_nodeColumns.m_contiguityStatus.end(), NOT_CONTIGUOUS);
     m_contiguitySearchDone = false;
 }
 
 void AssemblyGraph::resetAllNodeColours()
 {
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
+    for (int i = 0; i < m_deBruijnGraphNodes.size(); ++i)
     {
-        i.next();
-        if (i.value()->m_graphicsItemNode != 0)
-            i.value()->m_graphicsItemNode->setNodeColour();
+        DeBruijnNode * node = m_deBruijnGraphNodes.at(i);
+        if (node->m_graphicsItemNode != 0)
+            node->m_graphicsItemNode->setNodeColour();
     }
 }
 
-void AssemblyGraph::clearAllBlastHitPointers()
+//Nodes without a custom colour are grey.
+QColor AssemblyGraph::getNodeCustomColour(const DeBruijnNode * node) const
 {
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
-    {
-        i.next();
-        DeBruijnNode * node = i.value();
-        node->m_blastHits.clear();
-    }
+    return m_nodeCustomColours.value(node->m_columnIndex, QColor(190, 190, 190));
 }
 
+void AssemblyGraph::setNodeCustomColour(const DeBruijnNode * node, QColor colour)
+{
+    m_nodeCustomColours.insert(node->m_columnIndex, colour);
+}
 
+QString AssemblyGraph::getNodeCustomLabel(const DeBruijnNode * node) const
+{
+    return m_nodeCustomLabels.value(node->m_columnIndex);
+}
 
-void AssemblyGraph::determineGraphInfo()
+void AssemblyGraph::setNodeCustomLabel(const DeBruijnNode * node, QString label)
 {
-    m_shortestContig = std::numeric_limits<long long>::max();
-    m_longestContig = 0;
-    int nodeCount = 0;
-    long long totalLength = 0;
-    std::vector<double> nodeCoverages;
+    if (label.isEmpty())
+        m_nodeCustomLabels.remove(node->m_columnIndex);
+    else
+        m_nodeCustomLabels.insert(node->m_columnIndex, label);
+}
 
-    QMapIterator<long long, DeBruijnNode*> i(m_deBruijnGraphNodes);
-    while (i.hasNext())
-    {
-        i.next();
-        long long nodeLength = i.value()->m_length;
+const std::vector<BlastHit *> & AssemblyGraph::getNodeBlastHits(const DeBruijnNode * node) const
+{
+    static const std::vector<BlastHit *> noBlastHits;
+    QHash<int, std::vector<BlastHit *> >::const_iterator hits = m_nodeBlastHits.constFind(node->m_columnIndex);
+    if (hits == m_nodeBlastHits.constEnd())
+        return noBlastHits;
+    return hits.value();
+}
 
-        if (nodeLength < m_shortestContig)
-            m_shortestContig = nodeLength;
-        if (nodeLength > m_longestContig)
-            m_longestContig = nodeLength;
+//Velvet gives the reads for each strand of a node separately.  In single
+//mode, a node stands for both strands, so its reads are counted together.
+int AssemblyGraph::getNodeReadCount(const DeBruijnNode * node) const
+{
+    int readCount = m_readPositions.getReadCount(node->m_number);
+    if (!g_settings->doubleMode)
+        readCount += m_readPositions.getReadCount(node->m_reverseComplement->m_number);
+    return readCount;
+}
 
-        //Only add up the length for positive nodes
-        if (i.value()->m_number > 0)
-        {
-            totalLength += nodeLength;
-            ++nodeCount;
-        }
+//This function takes the names of the segments numbered 1 onwards, leaving
+//segmentNames empty.
+void AssemblyGraph::setSegmentNames(std::vector<QByteArray> * segmentNames)
+{
+    m_segmentNames.swap(*segmentNames);
+    std::vector<QByteArray>().swap(*segmentNames);
 
-        nodeCoverages.push_back(i.value()->m_coverage);
-    }
+    m_segmentNumbers.clear();
+    m_segmentNumbers.reserve(int(m_segmentNames.size()));
+    for (size_t i = 0; i < m_segmentNames.size(); ++i)
+        m_segmentNumbers.insert(m_segmentNames[i], (long long)(i + 1));
+}
+
+//A negative node is named with its segment name and a '-', as in GFA links.
+QString AssemblyGraph::getSegmentName(long long nodeNumber) const
+{
+    long long segmentNumber = nodeNumber < 0 ? -nodeNumber : nodeNumber;
+    if (segmentNumber == 0 || segmentNumber > (long long)(m_segmentNames.size()))
+        return QString();
+
+    QString name = QString::fromLatin1(m_segmentNames[segmentNumber - 1]);
+    if (nodeNumber < 0)
+        name += "-";
+    return name;
+}
+
+//This function accepts a segment name on its own or followed by '+' or '-'
+//for its strand.  It returns 0 if there is no such segment.
+long long AssemblyGraph::getNodeNumberFromSegmentName(QString name) const
+{
+    QByteArray nameBytes = name.trimmed().toLatin1();
+    long long segmentNumber = m_segmentNumbers.value(nameBytes, 0);
+    if (segmentNumber != 0 || nameBytes.isEmpty())
+        return segmentNumber;
+
+    char strand = nameBytes.at(nameBytes.length() - 1);
+    if (strand != '+' && strand != '-')
+        return 0;
+    nameBytes.chop(1);
+    segmentNumber = m_segmentNumbers.value(nameBytes, 0);
+    return strand == '-' ? -segmentNumber : segmentNumber;
+}
+
+void AssemblyGraph::addNodeBlastHit(const DeBruijnNode * node, BlastHit * hit)
+{
+    m_nodeBlastHits[node->m_columnIndex].push_back(hit);
+}
+
+void AssemblyGraph::clearAllBlastHitPointers()
+{
+    m_nodeBlastHits.clear();
+}
+
+
+
+//The node statistics are found in one parallel pass over the node columns,
+//using selection rather than sorting for the quantiles.
+void AssemblyGraph::determineGraphInfo()
+{
+    GraphStatistics statistics;
+    computeGraphStatistics(m_deBruijnGraphNodes, m_nodeColumns, &statistics);
 
     //Count up the edges.  Edges that are their own pairs will
     //not be counted, as these won't show up in single mode.
@@ -313,48 +421,36 @@ void AssemblyGraph::determineGraphInfo()
     }
     edgeCount /= 2;
 
-    m_nodeCount = nodeCount;
+    m_nodeCount = statistics.m_nodeCount;
     m_edgeCount = edgeCount;
-    m_totalLength = totalLength;
-    m_meanCoverage = getMeanDeBruijnGraphCoverage();
-
-    std::sort(nodeCoverages.begin(), nodeCoverages.end());
-
-    double firstQuartileIndex = nodeCoverages.size() / 4.0;
-    double medianIndex = nodeCoverages.size() / 2.0;
-    double thirdQuartileIndex = nodeCoverages.size() * 3.0 / 4.0;
+    m_totalLength = statistics.m_totalLength;
+    m_shortestContig = statistics.m_shortestContig;
+    m_longestContig = statistics.m_longestContig;
+    m_meanCoverage = statistics.m_meanCoverage;
+    m_firstQuartileCoverage = statistics.m_firstQuartileCoverage;
+    m_medianCoverage = statistics.m_medianCoverage;
+    m_thirdQuartileCoverage = statistics.m_thirdQuartileCoverage;
+    m_n50 = statistics.m_n50;
+    m_n90 = statistics.m_n90;
+    m_l50 = statistics.m_l50;
+    m_firstQuartileWeightedCoverage = statistics.m_firstQuartileWeightedCoverage;
+    m_medianWeightedCoverage = statistics.m_medianWeightedCoverage;
+    m_thirdQuartileWeightedCoverage = statistics.m_thirdQuartileWeightedCoverage;
+    m_gcContent = statistics.m_gcContent;
+    m_lengthHistogram = statistics.m_lengthHistogram;
+    m_coverageHistogram = statistics.m_coverageHistogram;
+}
 
-    m_firstQuartileCoverage = getValueUsingFractionalIndex(&nodeCoverages, firstQuartileIndex);
-    m_medianCoverage = getValueUsingFractionalIndex(&nodeCoverages, medianIndex);
-    m_thirdQuartileCoverage = getValueUsingFractionalIndex(&nodeCoverages, thirdQuartileIndex);
 
-    //Set the auto base pairs per segment
+//This is kept separate from determineGraphInfo, as the graph info is
+//determined when the graph is loaded, in the loading thread, but the
+//settings belong to the UI thread.
+void AssemblyGraph::setAutoBasePairsPerSegment()
+{
     int totalSegments = m_nodeCount * g_settings->meanSegmentsPerNode;
     g_settings->autoBasePairsPerSegment = m_totalLength / totalSegments;
 }
 
-double AssemblyGraph::getValueUsingFractionalIndex(std::vector<double> * doubleVector, double index)
-{
-    if (doubleVector->size() == 0)
-        return 0.0;
-    if (doubleVector->size() == 1)
-        return (*doubleVector)[0];
-
-    int wholePart = floor(index);
-
-    if (wholePart < 0)
-        return (*doubleVector)[0];
-    if (wholePart >= int(doubleVector->size()) - 1)
-        return (*doubleVector)[doubleVector->size() - 1];
-
-    double fractionalPart = index - wholePart;
-
-    double piece1 = (*doubleVector)[wholePart];
-    double piece2 = (*doubleVector)[wholePart+1];
-
-    return piece1 * (1.0 - fractionalPart) + piece2 * fractionalPart;
-}
-
 void AssemblyGraph::clearGraphInfo()
 {
     m_totalLength = 0;
@@ -365,4 +461,569 @@ void AssemblyGraph::clearGraphInfo()
     m_firstQuartileCoverage = 0.0;
     m_medianCoverage = 0.0;
     m_thirdQuartileCoverage = 0.0;
+
+    m_n50 = 0;
+    m_n90 = 0;
+    m_l50 = 0;
+    m_firstQuartileWeightedCoverage = 0.0;
+    m_medianWeightedCoverage = 0.0;
+    m_thirdQuartileWeightedCoverage = 0.0;
+    m_gcContent = -1.0;
+    m_lengthHistogram.clear();
+    m_coverageHistogram.clear();
+}
+
+
+//The automatic coverage colour range is taken from percentiles of the
+//coverage histogram, so changing the percentiles doesn't need the coverages
+//to be gone through again.
+void AssemblyGraph::getAutoCoverageValues(double * lowValue, double * highValue) const
+{
+    *lowValue = m_coverageHistogram.getPercentile(g_settings->lowCoveragePercentile);
+    *highValue = m_coverageHistogram.getPercentile(g_settings->highCoveragePercentile);
+}
+
+
+//Node widths can be limited to the width of a node at a percentile of
+//coverage, so a few very high coverage nodes don't dwarf the rest.  A
+//percentile of 100 means there is no limit, in which case this returns -1.
+double AssemblyGraph::getWidthCoverageCap() const
+{
+    if (g_settings->widthCoveragePercentileCap >= 100)
+        return -1.0;
+    return m_coverageHistogram.getPercentile(g_settings->widthCoveragePercentileCap);
+}
+
+
+
+void AssemblyGraph::buildDeBruijnGraphFromLastGraph(QString fullFileName, GraphLoadWorker * worker)
+{
+    m_trinityGraph = false;
+
+    //The file is memory-mapped and tokenised in place, so the only copies
+    //made of the file's contents are the node sequences themselves.
+    LineReader in(fullFileName);
+    if (in.open())
+    {
+        bool sequencesOnDemand = startLoadingSequencesOnDemand(fullFileName, in);
+        const char * line;
+        int lineLength;
+        const char * tokens[4];
+        int tokenLengths[4];
+        long long lineCount = 0;
+
+        while (in.readLine(&line, &lineLength))
+        {
+            if (++lineCount % 10000 == 0 && !worker->reportProgress(in.bytesRead(), in.totalBytes()))
+                throw "load cancelled";
+
+            if (lineStartsWith(line, lineLength, "NODE"))
+            {
+                if (splitOnWhitespace(line, lineLength, tokens, tokenLengths, 4) < 4)
+                    throw "load error";
+
+                long long nodeNumber = parseLongLong(tokens[1], tokenLengths[1]);
+                int nodeLength = int(parseLongLong(tokens[2], tokenLengths[2]));
+
+                double nodeCoverage;
+                if (nodeLength > 0)
+                    nodeCoverage = double(parseLongLong(tokens[3], tokenLengths[3])) / nodeLength; //IS THIS COLUMN ($COV_SHORT1) THE BEST ONE TO USE?
+                else
+                    nodeCoverage = double(parseLongLong(tokens[3], tokenLengths[3]));
+
+                DeBruijnNode * node = m_nodePool.create(nodeNumber, nodeLength, nodeCoverage, QByteArray());
+                DeBruijnNode * reverseComplementNode = m_nodePool.create(-nodeNumber, nodeLength, nodeCoverage, QByteArray());
+
+                //Each line is copied before the next is read, as reading a
+                //line from a gzipped file can invalidate the one before it.
+                //When loading sequences on demand, only the lines' positions
+                //are kept.
+                const char * sequenceLine = 0;
+                int sequenceLength = 0;
+                DeBruijnNode * strands[2] = {node, reverseComplementNode};
+                for (int j = 0; j < 2; ++j)
+                {
+                    in.readLine(&sequenceLine, &sequenceLength);
+                    if (sequencesOnDemand)
+                    {
+                        strands[j]->m_sequenceFileIndex = m_sequenceFile->addSequence(in.fileOffset(sequenceLine),
+                                                                                      sequenceLength, false);
+                    }
+                    else
+                        strands[j]->m_sequence = PackedSequence(sequenceLine, sequenceLength);
+                }
+
+                node->m_reverseComplement = reverseComplementNode;
+                reverseComplementNode->m_reverseComplement = node;
+                m_deBruijnGraphNodes.insert(node);
+                m_deBruijnGraphNodes.insert(reverseComplementNode);
+            }
+            else if (lineStartsWith(line, lineLength, "ARC"))
+            {
+                if (splitOnWhitespace(line, lineLength, tokens, tokenLengths, 3) < 3)
+                    throw "load error";
+
+                long long node1Number = parseLongLong(tokens[1], tokenLengths[1]);
+                long long node2Number = parseLongLong(tokens[2], tokenLengths[2]);
+
+                createDeBruijnEdge(node1Number, node2Number);
+            }
+
+            //Velvet writes the read tracking sections (NR and SEQ records)
+            //after all of the NODE and ARC records, so if they aren't wanted,
+            //the rest of the file can be skipped without reading it.
+            else if (lineStartsWith(line, lineLength, "NR") || lineStartsWith(line, lineLength, "SEQ"))
+            {
+                if (g_settings->readTrackingMode == SKIP_READ_TRACKING)
+                {
+                    in.skipToEnd();
+                    break;
+                }
+
+                //SEQ records (long read and reference positions) are not
+                //kept.  Their lines are skipped until the next NR or SEQ.
+                if (line[0] == 'S')
+                    continue;
+
+                //An NR record gives the node and its read count, followed by
+                //one line per read: read ID, offset from the start of the
+                //node and start coordinate in the read.
+                if (splitOnWhitespace(line, lineLength, tokens, tokenLengths, 3) < 3)
+                    throw "load error";
+
+                long long nodeNumber = parseLongLong(tokens[1], tokenLengths[1]);
+                int readCount = int(parseLongLong(tokens[2], tokenLengths[2]));
+                if (readCount < 0 || !m_readPositions.startNode(nodeNumber, readCount))
+                    throw "load error";
+
+                for (int i = 0; i < readCount; ++i)
+                {
+                    if (!in.readLine(&line, &lineLength) ||
+                            splitOnWhitespace(line, lineLength, tokens, tokenLengths, 3) < 3)
+                        throw "load error";
+
+                    m_readPositions.addRead(int(parseLongLong(tokens[0], tokenLengths[0])),
+                                            int(parseLongLong(tokens[1], tokenLengths[1])),
+                                            int(parseLongLong(tokens[2], tokenLengths[2])));
+                }
+                lineCount += readCount;
+            }
+        }
+
+        if (in.hasError())
+            throw "load error";
+        in.close();
+    }
+
+    if (m_deBruijnGraphNodes.size() == 0)
+        throw "load error";
+}
+
+
+
+
+void AssemblyGraph::buildDeBruijnGraphFromFastg(QString fullFileName, GraphLoadWorker * worker)
+{
+    m_trinityGraph = false;
+
+    LineReader in(fullFileName);
+    if (in.open())
+    {
+        bool sequencesOnDemand = startLoadingSequencesOnDemand(fullFileName, in);
+
+        //The file is cut into chunks at record boundaries and the chunks are
+        //parsed on the thread pool.  There are a few chunks per thread so the
+        //work stays balanced when some records are much longer than others.
+        //A gzipped file is read in blocks which are parsed as the next block
+        //is decompressed, whereas other files are parsed in one block.
+        std::vector<long long> edgeStartingNodeNumbers;
+        std::vector<long long> edgeEndingNodeNumbers;
+        const char * blockStart;
+        const char * blockEnd;
+        long long bytesBeforeBlock = 0;
+        while (in.readBlock(16 * 1024 * 1024, '>', &blockStart, &blockEnd))
+        {
+            std::vector<FastgChunk> chunks;
+            splitFastgIntoChunks(blockStart, blockEnd, QThread::idealThreadCount() * 4, &chunks);
+            if (sequencesOnDemand)
+            {
+                for (size_t i = 0; i < chunks.size(); ++i)
+                    chunks[i].m_fileStart = blockStart - in.fileOffset(blockStart);
+            }
+
+            long long bytesAfterBlock = in.bytesRead();
+            if (!worker->waitForFuture(QtConcurrent::map(chunks, parseFastgChunk),
+                                       bytesBeforeBlock, bytesAfterBlock, in.totalBytes()))
+                throw "load cancelled";
+            bytesBeforeBlock = bytesAfterBlock;
+
+            //The chunks are merged in file order, so the nodes and edges are
+            //the same as they would be from reading the file in one pass.
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                FastgChunk & chunk = chunks[i];
+                if (chunk.m_error)
+                    throw "load error";
+
+                for (size_t j = 0; j < chunk.m_nodes.size(); ++j)
+                {
+                    const FastgNodeRecord & record = chunk.m_nodes[j];
+                    DeBruijnNode * node = m_nodePool.create(record.m_number, record.m_length,
+                                                            record.m_coverage, record.m_sequence);
+                    if (sequencesOnDemand)
+                    {
+                        node->m_sequenceFileIndex = m_sequenceFile->addSequence(record.m_sequenceOffset,
+                                                                                record.m_sequenceLength, false);
+                    }
+                    DeBruijnNode * duplicateNode = m_deBruijnGraphNodes.value(record.m_number, 0);
+                    m_nodePool.destroy(duplicateNode);
+                    m_deBruijnGraphNodes.insert(node);
+                }
+
+                edgeStartingNodeNumbers.insert(edgeStartingNodeNumbers.end(),
+                                               chunk.m_edgeStartingNodeNumbers.begin(),
+                                               chunk.m_edgeStartingNodeNumbers.end());
+                edgeEndingNodeNumbers.insert(edgeEndingNodeNumbers.end(),
+                                             chunk.m_edgeEndingNodeNumbers.begin(),
+                                             chunk.m_edgeEndingNodeNumbers.end());
+
+                //Each chunk's records are freed as soon as they are merged.
+                std::vector<FastgNodeRecord>().swap(chunk.m_nodes);
+                std::vector<long long>().swap(chunk.m_edgeStartingNodeNumbers);
+                std::vector<long long>().swap(chunk.m_edgeEndingNodeNumbers);
+            }
+        }
+
+        if (in.hasError())
+            throw "load error";
+        in.close();
+
+        //If all went well, each node will have a reverse complement and the code
+        //will never get here.  However, I have noticed that some SPAdes fastg files
+        //have, for some reason, negative nodes with no positive counterpart.  For
+        //that reason, we will now make any reverse complement nodes for nodes that
+        //lack them.
+        for (int i = 0; i < m_deBruijnGraphNodes.size(); ++i)
+        {
+            DeBruijnNode * node = m_deBruijnGraphNodes.at(i);
+            makeReverseComplementNodeIfNecessary(node);
+        }
+        pointEachNodeToItsReverseComplement();
+
+
+        //Create all of the edges
+        for (size_t i = 0; i < edgeStartingNodeNumbers.size(); ++i)
+        {
+            long long node1Number = edgeStartingNodeNumbers[i];
+            long long node2Number = edgeEndingNodeNumbers[i];
+            createDeBruijnEdge(node1Number, node2Number);
+        }
+    }
+
+    if (m_deBruijnGraphNodes.size() == 0)
+        throw "load error";
+}
+
+
+//GFA segments have names rather than numbers.  If every name is a distinct
+//positive integer, the names are used as the node numbers.  Otherwise the
+//segments are numbered from 1 in the order they appear in the file.
+void AssemblyGraph::buildDeBruijnGraphFromGfa(QString fullFileName, GraphLoadWorker * worker)
+{
+    m_trinityGraph = false;
+
+    LineReader in(fullFileName);
+    if (!in.open())
+        throw "load error";
+    bool sequencesOnDemand = startLoadingSequencesOnDemand(fullFileName, in);
+
+    //As for FASTG files, the file is cut into chunks of whole lines which
+    //are parsed on the thread pool and then merged in file order.
+    std::vector<GfaSegmentRecord> segments;
+    std::vector<GfaLinkRecord> links;
+    const char * blockStart;
+    const char * blockEnd;
+    long long bytesBeforeBlock = 0;
+    while (in.readBlock(16 * 1024 * 1024, 0, &blockStart, &blockEnd))
+    {
+        std::vector<GfaChunk> chunks;
+        splitGfaIntoChunks(blockStart, blockEnd, QThread::idealThreadCount() * 4, &chunks);
+        if (sequencesOnDemand)
+        {
+            for (size_t i = 0; i < chunks.size(); ++i)
+                chunks[i].m_fileStart = blockStart - in.fileOffset(blockStart);
+        }
+
+        long long bytesAfterBlock = in.bytesRead();
+        if (!worker->waitForFuture(QtConcurrent::map(chunks, parseGfaChunk),
+                                   bytesBeforeBlock, bytesAfterBlock, in.totalBytes()))
+            throw "load cancelled";
+        bytesBeforeBlock = bytesAfterBlock;
+
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            GfaChunk & chunk = chunks[i];
+            if (chunk.m_error)
+                throw "load error";
+            segments.insert(segments.end(), chunk.m_segments.begin(), chunk.m_segments.end());
+            links.insert(links.end(), chunk.m_links.begin(), chunk.m_links.end());
+            std::vector<GfaSegmentRecord>().swap(chunk.m_segments);
+            std::vector<GfaLinkRecord>().swap(chunk.m_links);
+        }
+    }
+
+    if (in.hasError())
+        throw "load error";
+    in.close();
+
+    bool namesAreNumbers = true;
+    QHash<QByteArray, long long> nodeNumbers;
+    QSet<long long> usedNumbers;
+    nodeNumbers.reserve(int(segments.size()));
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        bool ok;
+        const QByteArray & name = segments[i].m_name;
+        long long number = parseLongLong(name.constData(), name.length(), &ok);
+        if (!ok || number <= 0 || name.at(0) == '+' || usedNumbers.contains(number))
+        {
+            namesAreNumbers = false;
+            break;
+        }
+        nodeNumbers.insert(name, number);
+        usedNumbers.insert(number);
+    }
+    if (!namesAreNumbers)
+    {
+        nodeNumbers.clear();
+        std::vector<QByteArray> segmentNames;
+        segmentNames.reserve(segments.size());
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            //GFA doesn't allow two segments with the same name.
+            if (nodeNumbers.contains(segments[i].m_name))
+                throw "load error";
+            nodeNumbers.insert(segments[i].m_name, (long long)(i + 1));
+            segmentNames.push_back(segments[i].m_name);
+        }
+        setSegmentNames(&segmentNames);
+    }
+
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        const GfaSegmentRecord & segment = segments[i];
+        long long nodeNumber = nodeNumbers.value(segment.m_name);
+        DeBruijnNode * node = m_nodePool.create(nodeNumber, segment.m_length,
+                                                segment.m_coverage, segment.m_sequence);
+        if (sequencesOnDemand && segment.m_sequenceOffset >= 0)
+        {
+            node->m_sequenceFileIndex = m_sequenceFile->addSequence(segment.m_sequenceOffset,
+                                                                    segment.m_length, false);
+        }
+        DeBruijnNode * duplicateNode = m_deBruijnGraphNodes.value(nodeNumber, 0);
+        m_nodePool.destroy(duplicateNode);
+        m_deBruijnGraphNodes.insert(node);
+    }
+    std::vector<GfaSegmentRecord>().swap(segments);
+
+    //GFA files only contain the positive strand of each segment, so the
+    //reverse complement nodes are made now.
+    for (int i = 0; i < m_deBruijnGraphNodes.size(); ++i)
+    {
+        DeBruijnNode * node = m_deBruijnGraphNodes.at(i);
+        makeReverseComplementNodeIfNecessary(node);
+    }
+    pointEachNodeToItsReverseComplement();
+
+    //A link from a segment's '-' orientation uses that segment's negative
+    //node.  Links to segments that aren't in the file are skipped by
+    //createDeBruijnEdge.
+    for (size_t j = 0; j < links.size(); ++j)
+    {
+        const GfaLinkRecord & link = links[j];
+        long long node1Number = nodeNumbers.value(link.m_fromName, 0);
+        long long node2Number = nodeNumbers.value(link.m_toName, 0);
+        if (node1Number == 0 || node2Number == 0)
+            continue;
+        if (link.m_fromNegative)
+            node1Number = -node1Number;
+        if (link.m_toNegative)
+            node2Number = -node2Number;
+        createDeBruijnEdge(node1Number, node2Number);
+    }
+
+    if (m_deBruijnGraphNodes.size() == 0)
+        throw "load error";
+}
+
+
+void AssemblyGraph::buildDeBruijnGraphFromTrinityFasta(QString fullFileName, GraphLoadWorker * worker)
+{
+    m_trinityGraph = true;
+
+    //The records are read in batches, so the file's sequences are never all
+    //held in memory at once.  Each batch is cut into chunks of records which
+    //are parsed on the thread pool, with a few chunks per thread so the work
+    //stays balanced.
+    FastaReader in(fullFileName);
+    if (!in.open())
+        throw "load error";
+
+    std::vector<long long> edgeStartingNodeNumbers;
+    std::vector<long long> edgeEndingNodeNumbers;
+
+    const long long batchBytes = 16 * 1024 * 1024;
+    int chunkCount = QThread::idealThreadCount() * 4;
+    long long bytesBeforeBatch = 0;
+    bool moreRecords = true;
+    while (moreRecords)
+    {
+        std::vector<QByteArray> names;
+        std::vector<QByteArray> sequences;
+        long long recordBytes = 0;
+        QByteArray name;
+        QByteArray sequence;
+        while (recordBytes < batchBytes)
+        {
+            moreRecords = in.readRecord(&name, &sequence);
+            if (!moreRecords)
+                break;
+            recordBytes += name.length() + sequence.length();
+            names.push_back(name);
+            sequences.push_back(sequence);
+        }
+        if (names.empty())
+            break;
+
+        std::vector<TrinityChunk> chunks(std::min(size_t(chunkCount), names.size()));
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            size_t first = names.size() * i / chunks.size();
+            size_t last = names.size() * (i + 1) / chunks.size();
+            chunks[i].m_names.assign(names.begin() + first, names.begin() + last);
+            chunks[i].m_sequences.assign(sequences.begin() + first, sequences.begin() + last);
+            chunks[i].m_existingNodes = &m_deBruijnGraphNodes;
+        }
+        std::vector<QByteArray>().swap(names);
+        std::vector<QByteArray>().swap(sequences);
+
+        long long bytesAfterBatch = in.bytesRead();
+        if (!worker->waitForFuture(QtConcurrent::map(chunks, parseTrinityChunk),
+                                   bytesBeforeBatch, bytesAfterBatch, in.totalBytes()))
+            throw "load cancelled";
+        bytesBeforeBatch = bytesAfterBatch;
+
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            TrinityChunk & chunk = chunks[i];
+            if (chunk.m_error)
+                throw "load error";
+
+            //A node made by an earlier chunk of this batch was first seen
+            //there, so this chunk's record for it is dropped.
+            for (size_t j = 0; j < chunk.m_nodes.size(); ++j)
+            {
+                const TrinityNodeRecord & record = chunk.m_nodes[j];
+                if (m_deBruijnGraphNodes.contains(record.m_number))
+                    continue;
+                DeBruijnNode * node = m_nodePool.create(record.m_number, record.m_length, 0.0, record.m_sequence);
+                m_deBruijnGraphNodes.insert(node);
+            }
+
+            edgeStartingNodeNumbers.insert(edgeStartingNodeNumbers.end(),
+                                           chunk.m_edgeStartingNodeNumbers.begin(),
+                                           chunk.m_edgeStartingNodeNumbers.end());
+            edgeEndingNodeNumbers.insert(edgeEndingNodeNumbers.end(),
+                                         chunk.m_edgeEndingNodeNumbers.begin(),
+                                         chunk.m_edgeEndingNodeNumbers.end());
+
+            std::vector<TrinityNodeRecord>().swap(chunk.m_nodes);
+            std::vector<long long>().swap(chunk.m_edgeStartingNodeNumbers);
+            std::vector<long long>().swap(chunk.m_edgeEndingNodeNumbers);
+        }
+    }
+
+    if (in.hasError())
+        throw "load error";
+
+    //Even though the Trinity.fasta file only contains positive nodes, Bandage
+    //expects negative reverse complements nodes, so make them now.
+    for (int i = 0; i < m_deBruijnGraphNodes.size(); ++i)
+    {
+        DeBruijnNode * node = m_deBruijnGraphNodes.at(i);
+        makeReverseComplementNodeIfNecessary(node);
+    }
+    pointEachNodeToItsReverseComplement();
+
+    //Create all of the edges.  The createDeBruijnEdge function checks for
+    //duplicates, so it's okay if we try to add the same edge multiple times.
+    for (size_t i = 0; i < edgeStartingNodeNumbers.size(); ++i)
+    {
+        long long node1Number = edgeStartingNodeNumbers[i];
+        long long node2Number = edgeEndingNodeNumbers[i];
+        createDeBruijnEdge(node1Number, node2Number);
+    }
+
+    if (m_deBruijnGraphNodes.size() == 0)
+        throw "load error";
+}
+
+
+//This function sets up the given file to give node sequences on demand, if
+//that setting is on.  It returns false (and the loader keeps the sequences
+//in memory) if the setting is off or the file can't be read at an offset,
+//which is the case for gzipped files.
+bool AssemblyGraph::startLoadingSequencesOnDemand(QString fullFileName, const LineReader & in)
+{
+    if (g_settings->sequenceLoadingMode != LOAD_SEQUENCES_ON_DEMAND || !in.givesFileOffsets())
+        return false;
+
+    SequenceFile * sequenceFile = new SequenceFile(fullFileName);
+    if (!sequenceFile->open())
+    {
+        delete sequenceFile;
+        return false;
+    }
+
+    delete m_sequenceFile;
+    m_sequenceFile = sequenceFile;
+    return true;
+}
+
+
+void AssemblyGraph::makeReverseComplementNodeIfNecessary(DeBruijnNode * node)
+{
+    long long  reverseComplementNumber = -node->m_number;
+    if (!m_deBruijnGraphNodes.contains(reverseComplementNumber))
+    {
+        //The new node doesn't get a sequence of its own: it gives the reverse
+        //complement of the original node's sequence when asked.  A node
+        //whose sequence is read on demand gets a reverse complement which
+        //reads the same part of the file.
+        DeBruijnNode * newNode = m_nodePool.create(reverseComplementNumber, node->m_length, node->m_coverage, PackedSequence());
+        if (node->m_sequenceFileIndex >= 0)
+            newNode->m_sequenceFileIndex = m_sequenceFile->addReverseComplement(node->m_sequenceFileIndex);
+        else
+            newNode->m_sequenceFromReverseComplement = true;
+        m_deBruijnGraphNodes.insert(newNode);
+    }
+}
+
+
+void AssemblyGraph::pointEachNodeToItsReverseComplement()
+{
+    for (int i = 0; i < m_deBruijnGraphNodes.size(); ++i)
+    {
+        DeBruijnNode * positiveNode = m_deBruijnGraphNodes.at(i);
+
+        if (positiveNode->m_number > 0)
+        {
+            DeBruijnNode * negativeNode = m_deBruijnGraphNodes.value(-(positiveNode->m_number), 0);
+            if (negativeNode != 0)
+            {
+                positiveNode->m_reverseComplement = negativeNode;
+                negativeNode->m_reverseComplement = positiveNode;
+            }
+        }
+    }
 }
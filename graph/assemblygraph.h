@@ -23,10 +23,22 @@
 #include "ogdf/basic/Graph.h"
 #include "ogdf/basic/GraphAttributes.h"
 #include <QString>
-#include <QMap>
+#include <QHash>
+#include <QPair>
+#include <QColor>
+#include "readpositions.h"
+#include "debruijnnodetable.h"
+#include "objectpool.h"
+#include "nodecolumns.h"
+#include "loghistogram.h"
 
 class DeBruijnNode;
 class DeBruijnEdge;
+class GraphLoadWorker;
+class GraphCache;
+class SequenceFile;
+class LineReader;
+class BlastHit;
 
 class AssemblyGraph
 {
@@ -34,8 +46,38 @@ public:
     AssemblyGraph();
     ~AssemblyGraph();
 
-    QMap<long long, DeBruijnNode*> m_deBruijnGraphNodes;
+    DeBruijnNodeTable m_deBruijnGraphNodes;
     std::vector<DeBruijnEdge*> m_deBruijnGraphEdges;
+    QHash<QPair<long long, long long>, DeBruijnEdge*> m_deBruijnGraphEdgeIndex;
+    std::vector<DeBruijnEdge*> m_adjacentEdges;
+    NodeColumns m_nodeColumns;
+
+    //Custom colours, custom labels and BLAST hits are only given to a few
+    //nodes, so they are kept here by node index instead of in every node.
+    QHash<int, QColor> m_nodeCustomColours;
+    QHash<int, QString> m_nodeCustomLabels;
+    QHash<int, std::vector<BlastHit *> > m_nodeBlastHits;
+    ReadPositions m_readPositions;
+    GraphCache * m_graphCache;
+
+    //GFA segments whose names aren't all distinct positive integers are
+    //numbered from 1 in file order.  Their names are kept here, so the name
+    //of nodes n and -n is m_segmentNames[n - 1].
+    std::vector<QByteArray> m_segmentNames;
+    QHash<QByteArray, long long> m_segmentNumbers;
+
+    //The graph's nodes and edges are made in these pools, which free them
+    //all at once when the graph is cleaned up.
+    ObjectPool<DeBruijnNode> m_nodePool;
+    ObjectPool<DeBruijnEdge> m_edgePool;
+
+    //These are the OGDF nodes for every drawn node, with each node's OGDF
+    //nodes next to each other.  They are cleared when the drawing is.
+    std::vector<ogdf::node> m_ogdfNodes;
+
+    //When sequences are loaded on demand, this reads them from the graph
+    //file.  Otherwise it is null.
+    SequenceFile * m_sequenceFile;
 
     ogdf::Graph * m_ogdfGraph;
     ogdf::GraphAttributes * m_graphAttributes;
@@ -49,24 +91,55 @@ public:
     double m_firstQuartileCoverage;
     double m_medianCoverage;
     double m_thirdQuartileCoverage;
+    long long m_n50;
+    long long m_n90;
+    int m_l50;
+    double m_firstQuartileWeightedCoverage;
+    double m_medianWeightedCoverage;
+    double m_thirdQuartileWeightedCoverage;
+    double m_gcContent;
+    LogHistogram m_lengthHistogram;
+    LogHistogram m_coverageHistogram;
     bool m_trinityGraph;
     bool m_contiguitySearchDone;
 
     void cleanUp();
     void createDeBruijnEdge(long long node1Number, long long node2Number);
+    void buildEdgeAdjacency();
+    void buildNodeColumns();
     void clearOgdfGraphAndResetNodes();
-    QByteArray getReverseComplement(QByteArray forwardSequence);
+    static QByteArray getReverseComplement(QByteArray forwardSequence);
     void resetEdges();
     double getMeanDeBruijnGraphCoverage(bool drawnNodesOnly = false);
     double getMaxDeBruijnGraphCoverageOfDrawnNodes();
     void resetNodeContiguityStatus();
     void resetAllNodeColours();
+    QColor getNodeCustomColour(const DeBruijnNode * node) const;
+    void setNodeCustomColour(const DeBruijnNode * node, QColor colour);
+    QString getNodeCustomLabel(const DeBruijnNode * node) const;
+    void setNodeCustomLabel(const DeBruijnNode * node, QString label);
+    const std::vector<BlastHit *> & getNodeBlastHits(const DeBruijnNode * node) const;
+    void addNodeBlastHit(const DeBruijnNode * node, BlastHit * hit);
+    int getNodeReadCount(const DeBruijnNode * node) const;
+    void setSegmentNames(std::vector<QByteArray> * segmentNames);
+    bool hasSegmentNames() const {return !m_segmentNames.empty();}
+    QString getSegmentName(long long nodeNumber) const;
+    long long getNodeNumberFromSegmentName(QString name) const;
     void clearAllBlastHitPointers();
     void determineGraphInfo();
+    void setAutoBasePairsPerSegment();
     void clearGraphInfo();
+    void getAutoCoverageValues(double * lowValue, double * highValue) const;
+    double getWidthCoverageCap() const;
+    void buildDeBruijnGraphFromLastGraph(QString fullFileName, GraphLoadWorker * worker);
+    void buildDeBruijnGraphFromFastg(QString fullFileName, GraphLoadWorker * worker);
+    void buildDeBruijnGraphFromTrinityFasta(QString fullFileName, GraphLoadWorker * worker);
+    void buildDeBruijnGraphFromGfa(QString fullFileName, GraphLoadWorker * worker);
 
 private:
-    double getValueUsingFractionalIndex(std::vector<double> * doubleVector, double index);
+    bool startLoadingSequencesOnDemand(QString fullFileName, const LineReader & in);
+    void makeReverseComplementNodeIfNecessary(DeBruijnNode * node);
+    void pointEachNodeToItsReverseComplement();
 };
 
 #endif // ASSEMBLYGRAPH_H
@@ -19,7 +19,6 @@
 #include "debruijnedge.h"
 #include <cmath>
 #include "../program/settings.h"
-#include "ogdfnode.h"
 #include <QApplication>
 
 DeBruijnEdge::DeBruijnEdge(DeBruijnNode *startingNode, DeBruijnNode *endingNode) :
@@ -77,22 +76,22 @@ bool DeBruijnEdge::edgeIsVisible()
 }
 
 
-void DeBruijnEdge::addToOgdfGraph(ogdf::Graph * ogdfGraph)
+void DeBruijnEdge::addToOgdfGraph(ogdf::Graph * ogdfGraph, const std::vector<ogdf::node> & ogdfNodes)
 {
     ogdf::node firstEdgeOgdfNode;
     ogdf::node secondEdgeOgdfNode;
 
     if (m_startingNode->inOgdf())
-        firstEdgeOgdfNode = m_startingNode->m_ogdfNode->getLast();
+        firstEdgeOgdfNode = m_startingNode->getLastOgdfNode(ogdfNodes);
     else if (m_startingNode->m_reverseComplement->inOgdf())
-        firstEdgeOgdfNode = m_startingNode->m_reverseComplement->m_ogdfNode->getFirst();
+        firstEdgeOgdfNode = m_startingNode->m_reverseComplement->getFirstOgdfNode(ogdfNodes);
     else
         return; //Ending node or its reverse complement isn't in OGDF
 
     if (m_endingNode->inOgdf())
-        secondEdgeOgdfNode = m_endingNode->m_ogdfNode->getFirst();
+        secondEdgeOgdfNode = m_endingNode->getFirstOgdfNode(ogdfNodes);
     else if (m_endingNode->m_reverseComplement->inOgdf())
-        secondEdgeOgdfNode = m_endingNode->m_reverseComplement->m_ogdfNode->getLast();
+        secondEdgeOgdfNode = m_endingNode->m_reverseComplement->getLastOgdfNode(ogdfNodes);
     else
         return; //Ending node or its reverse complement isn't in OGDF
 
@@ -140,11 +139,12 @@ void DeBruijnEdge::tracePaths(bool forward,
 
     //If the code got here, then more steps remain.
     //Find the edges that are in the correct direction.
-    std::vector<DeBruijnEdge *> nextEdges = findNextEdgesInPath(nextNode, forward);
+    DeBruijnEdge * const * nextEdgesBegin = forward ? nextNode->outEdgesBegin() : nextNode->inEdgesBegin();
+    DeBruijnEdge * const * nextEdgesEnd = forward ? nextNode->outEdgesEnd() : nextNode->inEdgesEnd();
 
     //If there are no next edges, then we are finished with the
     //path search, even though steps remain.
-    if (nextEdges.size() == 0)
+    if (nextEdgesBegin == nextEdgesEnd)
     {
         allPaths->push_back(pathSoFar);
         return;
@@ -153,9 +153,9 @@ void DeBruijnEdge::tracePaths(bool forward,
     //Call this function on all of the next edges.
     //However, we also need to check to see if we are tracing a loop
     //and stop if that is the case.
-    for (size_t i = 0; i < nextEdges.size(); ++i)
+    for (DeBruijnEdge * const * i = nextEdgesBegin; i != nextEdgesEnd; ++i)
     {
-        DeBruijnEdge * nextEdge = nextEdges[i];
+        DeBruijnEdge * nextEdge = *i;
 
         //Determine the node that this next edge leads to.
         DeBruijnNode * nextNextNode;
@@ -238,20 +238,21 @@ bool DeBruijnEdge::leadsOnlyToNode(bool forward,
 
     //If the code got here, then more steps remain.
     //Find the edges that are in the correct direction.
-    std::vector<DeBruijnEdge *> nextEdges = findNextEdgesInPath(nextNode, forward);
+    DeBruijnEdge * const * nextEdgesBegin = forward ? nextNode->outEdgesBegin() : nextNode->inEdgesBegin();
+    DeBruijnEdge * const * nextEdgesEnd = forward ? nextNode->outEdgesEnd() : nextNode->inEdgesEnd();
 
     //If there are no next edges, then the search failed, even
     //though steps remain.
-    if (nextEdges.size() == 0)
+    if (nextEdgesBegin == nextEdgesEnd)
         return false;
 
     //In order for the search to succeed, this function needs to return true
     //for all of the nextEdges.
     //However, we also need to check to see if we are tracing a loop
     //and stop if that is the case.
-    for (size_t i = 0; i < nextEdges.size(); ++i)
+    for (DeBruijnEdge * const * i = nextEdgesBegin; i != nextEdgesEnd; ++i)
     {
-        DeBruijnEdge * nextEdge = nextEdges[i];
+        DeBruijnEdge * nextEdge = *i;
 
         //Determine the node that this next edge leads to.
         DeBruijnNode * nextNextNode;
@@ -273,23 +274,3 @@ bool DeBruijnEdge::leadsOnlyToNode(bool forward,
     //If the code got here, then the search succeeded!
     return true;
 }
-
-
-std::vector<DeBruijnEdge *> DeBruijnEdge::findNextEdgesInPath(DeBruijnNode * nextNode,
-                                                              bool forward)
-{
-    std::vector<DeBruijnEdge *> nextEdges;
-    for (size_t i = 0; i < nextNode->m_edges.size(); ++i)
-    {
-        DeBruijnEdge * edge = nextNode->m_edges[i];
-
-        //If forward, we're looking for edges that lead away from
-        //nextNode.  If backward, we're looking for edges that lead
-        //into nextNode.
-        if ((forward && edge->m_startingNode == nextNode) ||
-                (!forward && edge->m_endingNode == nextNode))
-            nextEdges.push_back(edge);
-    }
-
-    return nextEdges;
-}
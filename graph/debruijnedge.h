@@ -37,7 +37,7 @@ public:
 
     bool isStartingNode(DeBruijnNode * node) {return node == m_startingNode;}
     DeBruijnNode * getOtherNode(DeBruijnNode * node);
-    void addToOgdfGraph(ogdf::Graph * ogdfGraph);
+    void addToOgdfGraph(ogdf::Graph * ogdfGraph, const std::vector<ogdf::node> & ogdfNodes);
     void reset() {m_graphicsItemEdge = 0; m_drawn = false;}
     void determineIfDrawn() {m_drawn = edgeIsVisible();}
     void tracePaths(bool forward,
@@ -50,8 +50,6 @@ public:
                          DeBruijnNode * target,
                          std::vector<DeBruijnNode *> pathSoFar,
                          bool includeReverseComplement);
-    std::vector<DeBruijnEdge *> findNextEdgesInPath(DeBruijnNode * nextNode,
-                                                    bool forward);
     int timesNodeInPath(DeBruijnNode * node, std::vector<DeBruijnNode *> * path);
 
 private:
@@ -18,47 +18,40 @@
 
 #include "debruijnnode.h"
 #include "debruijnedge.h"
-#include "ogdfnode.h"
 #include "../program/settings.h"
 #include "graphicsitemnode.h"
 #include <math.h>
 #include "../blast/blasthit.h"
 #include "assemblygraph.h"
+#include "sequencefile.h"
 #include <set>
 #include <QApplication>
 
-DeBruijnNode::DeBruijnNode(long long number, int length, double coverage, QByteArray sequence) :
+DeBruijnNode::DeBruijnNode(long long number, int length, double coverage, PackedSequence sequence) :
     m_number(number),
     m_length(length),
     m_coverage(coverage),
     m_coverageRelativeToMeanDrawnCoverage(1.0),
     m_sequence(sequence),
+    m_sequenceFileIndex(-1),
+    m_sequenceFromReverseComplement(false),
     m_contiguityStatus(NOT_CONTIGUOUS),
     m_reverseComplement(0),
-    m_ogdfNode(0),
+    m_ogdfNodeStart(0),
+    m_ogdfNodeCount(0),
     m_graphicsItemNode(0),
+    m_adjacentEdges(0),
+    m_outEdgeCount(0),
+    m_inEdgeCount(0),
     m_startingNode(false),
     m_drawn(false),
-    m_highestDistanceInNeighbourSearch(0),
-    m_customColour(QColor(190, 190, 190))
+    m_columnIndex(0)
 {
 }
 
 
 DeBruijnNode::~DeBruijnNode()
 {
-    if (m_ogdfNode != 0)
-        delete m_ogdfNode;
-}
-
-
-
-//This function adds an edge to the Node, but only if the edge hasn't already
-//been added.
-void DeBruijnNode::addEdge(DeBruijnEdge * edge)
-{
-    if (std::find(m_edges.begin(), m_edges.end(), edge) == m_edges.end())
-        m_edges.push_back(edge);
 }
 
 
@@ -66,27 +59,25 @@ void DeBruijnNode::addEdge(DeBruijnEdge * edge)
 //file was loaded - no contiguity status and no OGDF nodes.
 void DeBruijnNode::resetNode()
 {
-    if (m_ogdfNode != 0)
-        delete m_ogdfNode;
-    m_ogdfNode = 0;
+    m_ogdfNodeStart = 0;
+    m_ogdfNodeCount = 0;
     m_graphicsItemNode = 0;
     m_contiguityStatus = NOT_CONTIGUOUS;
     m_startingNode = false;
-    m_drawn = false;
-    m_highestDistanceInNeighbourSearch = 0;
+    setDrawn(false);
+    g_assemblyGraph->m_nodeColumns.m_contiguityStatus[m_columnIndex] = NOT_CONTIGUOUS;
 }
 
 
-void DeBruijnNode::addToOgdfGraph(ogdf::Graph * ogdfGraph)
+//The OGDF nodes made for this node are added to the end of the graph's
+//array of OGDF nodes.
+void DeBruijnNode::addToOgdfGraph(ogdf::Graph * ogdfGraph, std::vector<ogdf::node> * ogdfNodes)
 {
     //If this node or its reverse complement is already in OGDF, then
     //it's not necessary to make the node.
     if (thisOrReverseComplementInOgdf())
         return;
 
-    //Create the OgdfNode object
-    m_ogdfNode = new OgdfNode();
-
     //Each node in the Velvet sense is made up of multiple nodes in the
     //OGDF sense.  This way, Velvet nodes appear as lines whose length
     //corresponds to the sequence length.
@@ -95,12 +86,15 @@ void DeBruijnNode::addToOgdfGraph(ogdf::Graph * ogdfGraph)
         numberOfGraphEdges = 1;
     int numberOfGraphNodes = numberOfGraphEdges + 1;
 
+    m_ogdfNodeStart = int(ogdfNodes->size());
+    m_ogdfNodeCount = numberOfGraphNodes;
+
     ogdf::node newNode = 0;
     ogdf::node previousNode = 0;
     for (int i = 0; i < numberOfGraphNodes; ++i)
     {
         newNode = ogdfGraph->newNode();
-        m_ogdfNode->addOgdfNode(newNode);
+        ogdfNodes->push_back(newNode);
 
         if (i > 0)
             ogdfGraph->newEdge(previousNode, newNode);
@@ -132,10 +126,14 @@ void DeBruijnNode::determineContiguity()
     //outward.  Nodes in any of the paths for an edge are
     //MAYBE_CONTIGUOUS.  Nodes in all of the paths for an edge
     //are CONTIGUOUS.
-    for (size_t i = 0; i < m_edges.size(); ++i)
+    //The outgoing edges come first in the adjacency array, so a loop is only
+    //traced in the forward direction.
+    for (DeBruijnEdge * const * i = outEdgesBegin(); i != inEdgesEnd(); ++i)
     {
-        DeBruijnEdge * edge = m_edges[i];
-        bool outgoingEdge = (this == edge->m_startingNode);
+        DeBruijnEdge * edge = *i;
+        bool outgoingEdge = (i < outEdgesEnd());
+        if (!outgoingEdge && edge->m_startingNode == this)
+            continue;
 
         std::vector< std::vector <DeBruijnNode *> > allPaths;
         edge->tracePaths(outgoingEdge, g_settings->contiguitySearchSteps, &allPaths, this);
@@ -251,10 +249,12 @@ std::vector<DeBruijnNode *> DeBruijnNode::getNodesCommonToAllPaths(std::vector<
 //all paths lead either to the node or its reverse complement node.
 bool DeBruijnNode::doesPathLeadOnlyToNode(DeBruijnNode * node, bool includeReverseComplement)
 {
-    for (size_t i = 0; i < m_edges.size(); ++i)
+    for (DeBruijnEdge * const * i = outEdgesBegin(); i != inEdgesEnd(); ++i)
     {
-        DeBruijnEdge * edge = m_edges[i];
-        bool outgoingEdge = (this == edge->m_startingNode);
+        DeBruijnEdge * edge = *i;
+        bool outgoingEdge = (i < outEdgesEnd());
+        if (!outgoingEdge && edge->m_startingNode == this)
+            continue;
 
         std::vector<DeBruijnNode *> pathSoFar;
         pathSoFar.push_back(this);
@@ -270,7 +270,20 @@ bool DeBruijnNode::doesPathLeadOnlyToNode(DeBruijnNode * node, bool includeRever
 void DeBruijnNode::setContiguityStatus(ContiguityStatus newStatus)
 {
     if (newStatus < m_contiguityStatus)
+    {
         m_contiguityStatus = newStatus;
+        g_assemblyGraph->m_nodeColumns.m_contiguityStatus[m_columnIndex] = newStatus;
+    }
+}
+
+
+//The drawn status is set through here, so the graph's drawn column and its
+//drawn node totals always match the node.  These setters are only used on
+//the main window's graph, once it has been loaded and its columns built.
+void DeBruijnNode::setDrawn(bool drawn)
+{
+    m_drawn = drawn;
+    g_assemblyGraph->m_nodeColumns.setDrawn(m_columnIndex, drawn);
 }
 
 
@@ -292,22 +305,60 @@ bool DeBruijnNode::isOnlyPathInItsDirection(DeBruijnNode * connectedNode,
 }
 
 
-QByteArray DeBruijnNode::getFasta(bool useTrinityNames)
+//Only one node of a reverse complement pair needs to hold a sequence: if the
+//other was made from it, that node's sequence is given by reverse
+//complementing it when needed.
+//When sequences are loaded on demand, the node only has an index into the
+//graph's sequence file, which reads the sequence from the graph file each
+//time it is needed.
+QByteArray DeBruijnNode::getSequence() const
+{
+    if (m_sequenceFromReverseComplement)
+        return AssemblyGraph::getReverseComplement(m_reverseComplement->getSequence());
+
+    if (m_sequenceFileIndex < 0)
+        return m_sequence.unpack();
+    return g_assemblyGraph->m_sequenceFile->getSequence(m_sequenceFileIndex);
+}
+
+
+int DeBruijnNode::getSequenceLength() const
+{
+    if (m_sequenceFromReverseComplement)
+        return m_reverseComplement->getSequenceLength();
+    if (m_sequenceFileIndex >= 0)
+        return g_assemblyGraph->m_sequenceFile->getSequenceLength(m_sequenceFileIndex);
+    return m_sequence.length();
+}
+
+
+QByteArray DeBruijnNode::getFasta(bool useOriginalNames)
 {
     QByteArray fasta = ">";
 
     //If the node came from a Trinity graph, create a
     //FASTA header that matches the Trinity style.
-    //This requires useTrinityNames to be set, because
+    //Likewise, a node from a GFA segment which was
+    //renumbered is given its segment name.
+    //This requires useOriginalNames to be set, because
     //in some situations (like when making a BLAST db),
-    //we don't want to use the Trinity style.
-    if (g_assemblyGraph->m_trinityGraph && useTrinityNames)
+    //we need the header to give the node number.
+    if (g_assemblyGraph->m_trinityGraph && useOriginalNames)
     {
         fasta += getTrinityNodeNameFromFullNodeNumber(m_number);
         fasta += "_len=";
         fasta += QString::number(m_length);
         fasta += "\n";
     }
+    else if (g_assemblyGraph->hasSegmentNames() && useOriginalNames)
+    {
+        fasta += g_assemblyGraph->getSegmentName(m_number);
+        fasta += " length=";
+        fasta += QString::number(m_length);
+        fasta += " cov=";
+        fasta += QString::number(m_coverage);
+        fasta += "\n";
+    }
     else
     {
         fasta += "NODE_";
@@ -319,73 +370,40 @@ QByteArray DeBruijnNode::getFasta(bool useTrinityNames)
         fasta += "\n";
     }
 
-    int charactersOnLine = 0;
-    for (int i = 0; i < m_sequence.length(); ++i)
+    //The sequence is copied a line at a time, into space made for it up front.
+    QByteArray sequence = getSequence();
+    fasta.reserve(fasta.length() + sequence.length() + sequence.length() / 60 + 1);
+    for (int i = 0; i < sequence.length(); i += 60)
     {
-        fasta += m_sequence.at(i);
-        ++charactersOnLine;
-        if (charactersOnLine >= 60)
-        {
+        int lineLength = qMin(60, sequence.length() - i);
+        fasta.append(sequence.constData() + i, lineLength);
+        if (lineLength == 60)
             fasta += "\n";
-            charactersOnLine = 0;
-        }
     }
 
     return fasta;
 }
 
 
-//This function recursively labels all nodes as drawn that are within a
-//certain distance of this node.  Whichever node called this will
-//definitely be drawn, so that one is excluded from the recursive call.
-void DeBruijnNode::labelNeighbouringNodesAsDrawn(int nodeDistance, DeBruijnNode * callingNode)
-{
-    if (m_highestDistanceInNeighbourSearch > nodeDistance)
-        return;
-    m_highestDistanceInNeighbourSearch = nodeDistance;
-
-    if (nodeDistance == 0)
-        return;
-
-    DeBruijnNode * otherNode;
-    for (size_t i = 0; i < m_edges.size(); ++i)
-    {
-        otherNode = m_edges[i]->getOtherNode(this);
-
-        if (otherNode == callingNode)
-            continue;
-
-        if (g_settings->doubleMode)
-            otherNode->m_drawn = true;
-        else //single mode
-        {
-            if (otherNode->m_number > 0)
-                otherNode->m_drawn = true;
-            else
-                otherNode->m_reverseComplement->m_drawn = true;
-        }
-        otherNode->labelNeighbouringNodesAsDrawn(nodeDistance-1, this);
-    }
-}
-
-
+//A node's BLAST hits are kept by the graph, as few nodes have any.
 bool DeBruijnNode::thisNodeHasBlastHits()
 {
-    return m_blastHits.size() > 0;
+    return g_assemblyGraph->getNodeBlastHits(this).size() > 0;
 }
 
 bool DeBruijnNode::thisNodeOrReverseComplementHasBlastHits()
 {
-    return m_blastHits.size() > 0 || m_reverseComplement->m_blastHits.size() > 0;
+    return thisNodeHasBlastHits() || m_reverseComplement->thisNodeHasBlastHits();
 }
 
 std::vector<BlastHitPart> DeBruijnNode::getBlastHitPartsForThisNode()
 {
+    const std::vector<BlastHit *> & blastHits = g_assemblyGraph->getNodeBlastHits(this);
     std::vector<BlastHitPart> returnVector;
 
-    for (size_t i = 0; i < m_blastHits.size(); ++i)
+    for (size_t i = 0; i < blastHits.size(); ++i)
     {
-        std::vector<BlastHitPart> hitParts = m_blastHits[i]->getBlastHitParts(false);
+        std::vector<BlastHitPart> hitParts = blastHits[i]->getBlastHitParts(false);
         returnVector.insert(returnVector.end(), hitParts.begin(), hitParts.end());
     }
 
@@ -402,15 +420,17 @@ std::vector<BlastHitPart> DeBruijnNode::getBlastHitPartsForThisNodeOrReverseComp
     //Look for blast hit parts on both the positive and the negative node,
     // since hits were previously filtered such that startPos < endPos,
     // hence we need to look at both positive and negative nodes to recover all hits.
+    const std::vector<BlastHit *> & positiveBlastHits = g_assemblyGraph->getNodeBlastHits(positiveNode);
+    const std::vector<BlastHit *> & negativeBlastHits = g_assemblyGraph->getNodeBlastHits(negativeNode);
     std::vector<BlastHitPart> returnVector;
-    for (size_t i = 0; i < positiveNode->m_blastHits.size(); ++i)
+    for (size_t i = 0; i < positiveBlastHits.size(); ++i)
     {
-        std::vector<BlastHitPart> hitParts = positiveNode->m_blastHits[i]->getBlastHitParts(false);
+        std::vector<BlastHitPart> hitParts = positiveBlastHits[i]->getBlastHitParts(false);
         returnVector.insert(returnVector.end(), hitParts.begin(), hitParts.end());
     }
-    for (size_t i = 0; i < negativeNode->m_blastHits.size(); ++i)
+    for (size_t i = 0; i < negativeBlastHits.size(); ++i)
     {
-        std::vector<BlastHitPart> hitParts = negativeNode->m_blastHits[i]->getBlastHitParts(true);
+        std::vector<BlastHitPart> hitParts = negativeBlastHits[i]->getBlastHitParts(true);
         returnVector.insert(returnVector.end(), hitParts.begin(), hitParts.end());
     }
 
@@ -422,6 +442,8 @@ QString DeBruijnNode::getNodeNumberText(bool commas)
 {
     if (g_assemblyGraph->m_trinityGraph)
         return getTrinityNodeNameFromFullNodeNumber(m_number);
+    else if (g_assemblyGraph->hasSegmentNames())
+        return g_assemblyGraph->getSegmentName(m_number);
     else if (commas)
         return formatIntForDisplay(m_number);
     else
@@ -23,47 +23,65 @@
 #include <vector>
 #include <ogdf/basic/Graph.h>
 #include "../program/globals.h"
-#include <QColor>
 #include "../blast/blasthitpart.h"
+#include "packedsequence.h"
 
-class OgdfNode;
 class DeBruijnEdge;
 class GraphicsItemNode;
 class BlastHit;
 
+//Each strand of a node is its own DeBruijnNode, and the two point to each
+//other through m_reverseComplement.  The only thing the two strands share is
+//their sequence: one of them can hold it for both (see
+//m_sequenceFromReverseComplement).  The graph isn't bidirected: there are
+//no strand flags, and nodes and edges still come in pairs of objects.
 class DeBruijnNode
 {
 public:
-    DeBruijnNode(long long number, int length, double coverage, QByteArray sequence);
+    DeBruijnNode(long long number, int length, double coverage, PackedSequence sequence);
     ~DeBruijnNode();
 
     long long m_number;
     int m_length;
     double m_coverage;
     double m_coverageRelativeToMeanDrawnCoverage;
-    QByteArray m_sequence;
+    PackedSequence m_sequence;
+    int m_sequenceFileIndex;
+    bool m_sequenceFromReverseComplement;
     ContiguityStatus m_contiguityStatus;
     DeBruijnNode * m_reverseComplement;
-    OgdfNode * m_ogdfNode;
+    int m_ogdfNodeStart;
+    int m_ogdfNodeCount;
     GraphicsItemNode * m_graphicsItemNode;
-    std::vector<DeBruijnEdge *> m_edges;
+    DeBruijnEdge ** m_adjacentEdges;
+    int m_outEdgeCount;
+    int m_inEdgeCount;
     bool m_startingNode;
     bool m_drawn;
-    int m_highestDistanceInNeighbourSearch;
-    QColor m_customColour;
-    QString m_customLabel;
-    std::vector<BlastHit *> m_blastHits;
+    int m_columnIndex;
 
-    void addEdge(DeBruijnEdge * edge);
+    //Once the graph is loaded, each node's edges are held in the graph's
+    //adjacency array: the edges leaving the node, then those entering it.
+    //A loop is in both ranges.
+    DeBruijnEdge * const * outEdgesBegin() const {return m_adjacentEdges;}
+    DeBruijnEdge * const * outEdgesEnd() const {return m_adjacentEdges + m_outEdgeCount;}
+    DeBruijnEdge * const * inEdgesBegin() const {return outEdgesEnd();}
+    DeBruijnEdge * const * inEdgesEnd() const {return inEdgesBegin() + m_inEdgeCount;}
     void resetNode();
     bool hasGraphicsItem() {return m_graphicsItemNode != 0;}
-    bool inOgdf() {return m_ogdfNode != 0;}
+    bool inOgdf() {return m_ogdfNodeCount > 0;}
     bool notInOgdf() {return !inOgdf();}
     bool thisOrReverseComplementInOgdf() {return (inOgdf() || m_reverseComplement->inOgdf());}
     bool thisOrReverseComplementNotInOgdf() {return !thisOrReverseComplementInOgdf();}
-    void addToOgdfGraph(ogdf::Graph * ogdfGraph);
+    void addToOgdfGraph(ogdf::Graph * ogdfGraph, std::vector<ogdf::node> * ogdfNodes);
+
+    //A node in OGDF is a chain of OGDF nodes, which are held in one array for
+    //the whole graph: this node's are the m_ogdfNodeCount from m_ogdfNodeStart.
+    ogdf::node getFirstOgdfNode(const std::vector<ogdf::node> & ogdfNodes) const {return ogdfNodes[m_ogdfNodeStart];}
+    ogdf::node getLastOgdfNode(const std::vector<ogdf::node> & ogdfNodes) const {return ogdfNodes[m_ogdfNodeStart + m_ogdfNodeCount - 1];}
     void determineContiguity();
     void setContiguityStatus(ContiguityStatus newStatus);
+    void setDrawn(bool drawn);
     bool isOnlyPathInItsDirection(DeBruijnNode * connectedNode,
                                   std::vector<DeBruijnNode *> * incomingNodes,
                                   std::vector<DeBruijnNode *> * outgoingNodes);
@@ -71,8 +89,9 @@ public:
                                      std::vector<DeBruijnNode *> * incomingNodes,
                                      std::vector<DeBruijnNode *> * outgoingNodes)
     {return !isOnlyPathInItsDirection(connectedNode, incomingNodes, outgoingNodes);}
-    QByteArray getFasta(bool useTrinityNames);
-    void labelNeighbouringNodesAsDrawn(int nodeDistance, DeBruijnNode * callingNode);
+    QByteArray getSequence() const;
+    int getSequenceLength() const;
+    QByteArray getFasta(bool useOriginalNames);
 
     bool thisNodeHasBlastHits();
     bool thisNodeOrReverseComplementHasBlastHits();
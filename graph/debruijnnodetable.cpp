@@ -0,0 +1,127 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "debruijnnodetable.h"
+#include "debruijnnode.h"
+#include <algorithm>
+
+DeBruijnNodeTable::DeBruijnNodeTable() :
+    m_slotMask(0)
+{
+}
+
+
+//Node numbers are often consecutive, so they are scrambled (by Fibonacci
+//hashing) before being used to pick a slot.
+size_t DeBruijnNodeTable::firstSlot(long long nodeNumber) const
+{
+    unsigned long long hash = (unsigned long long)(nodeNumber) * 0x9E3779B97F4A7C15ULL;
+    return size_t(hash ^ (hash >> 32)) & m_slotMask;
+}
+
+
+int DeBruijnNodeTable::indexOf(long long nodeNumber) const
+{
+    if (m_slots.empty())
+        return -1;
+
+    for (size_t slot = firstSlot(nodeNumber); ; slot = (slot + 1) & m_slotMask)
+    {
+        const Slot & s = m_slots[slot];
+        if (s.m_index < 0)
+            return -1;
+        if (s.m_number == nodeNumber)
+            return s.m_index;
+    }
+}
+
+
+DeBruijnNode * DeBruijnNodeTable::value(long long nodeNumber, DeBruijnNode * defaultValue) const
+{
+    int index = indexOf(nodeNumber);
+    if (index < 0)
+        return defaultValue;
+    return m_nodes[index];
+}
+
+
+//If there is already a node with the same number, the new node takes its
+//place (and position) in the table.  The old node is not deleted.
+void DeBruijnNodeTable::insert(DeBruijnNode * node)
+{
+    //The table is kept at most half full, so probe runs stay short.
+    if ((m_nodes.size() + 1) * 2 > m_slots.size())
+        rehash(std::max(m_slots.size() * 2, size_t(16)));
+
+    for (size_t slot = firstSlot(node->m_number); ; slot = (slot + 1) & m_slotMask)
+    {
+        Slot & s = m_slots[slot];
+        if (s.m_index < 0)
+        {
+            s.m_number = node->m_number;
+            s.m_index = int(m_nodes.size());
+            m_nodes.push_back(node);
+            return;
+        }
+        if (s.m_number == node->m_number)
+        {
+            m_nodes[s.m_index] = node;
+            return;
+        }
+    }
+}
+
+
+void DeBruijnNodeTable::reserve(int nodeCount)
+{
+    m_nodes.reserve(nodeCount);
+    size_t slotCount = 16;
+    while (slotCount < size_t(nodeCount) * 2)
+        slotCount *= 2;
+    if (slotCount > m_slots.size())
+        rehash(slotCount);
+}
+
+
+void DeBruijnNodeTable::clear()
+{
+    std::vector<DeBruijnNode *>().swap(m_nodes);
+    std::vector<Slot>().swap(m_slots);
+    m_slotMask = 0;
+}
+
+
+//The slot count must be a power of two.
+void DeBruijnNodeTable::rehash(size_t slotCount)
+{
+    Slot emptySlot;
+    emptySlot.m_number = 0;
+    emptySlot.m_index = -1;
+    m_slots.assign(slotCount, emptySlot);
+    m_slotMask = slotCount - 1;
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        long long nodeNumber = m_nodes[i]->m_number;
+        size_t slot = firstSlot(nodeNumber);
+        while (m_slots[slot].m_index >= 0)
+            slot = (slot + 1) & m_slotMask;
+        m_slots[slot].m_number = nodeNumber;
+        m_slots[slot].m_index = int(i);
+    }
+}
@@ -0,0 +1,65 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef DEBRUIJNNODETABLE_H
+#define DEBRUIJNNODETABLE_H
+
+#include <vector>
+#include <stddef.h>
+
+class DeBruijnNode;
+
+//This class holds the graph's nodes in a vector, in the order they were
+//added, so passes over the whole graph walk contiguous memory:
+//    for (int i = 0; i < table.size(); ++i)
+//        table.at(i)->...
+//Nodes are found by number through an open-addressing hash table (with
+//linear probing) from node number to position in the vector.  Nodes are
+//never removed, except all at once with clear().
+class DeBruijnNodeTable
+{
+public:
+    DeBruijnNodeTable();
+
+    int size() const {return int(m_nodes.size());}
+    bool isEmpty() const {return m_nodes.empty();}
+    DeBruijnNode * at(int index) const {return m_nodes[index];}
+    int indexOf(long long nodeNumber) const;
+    bool contains(long long nodeNumber) const {return indexOf(nodeNumber) >= 0;}
+    DeBruijnNode * value(long long nodeNumber, DeBruijnNode * defaultValue = 0) const;
+
+    void insert(DeBruijnNode * node);
+    void reserve(int nodeCount);
+    void clear();
+
+private:
+    struct Slot
+    {
+        long long m_number;
+        int m_index;
+    };
+
+    std::vector<DeBruijnNode *> m_nodes;
+    std::vector<Slot> m_slots;
+    size_t m_slotMask;
+
+    size_t firstSlot(long long nodeNumber) const;
+    void rehash(size_t slotCount);
+};
+
+#endif // DEBRUIJNNODETABLE_H
@@ -0,0 +1,225 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "fastgparser.h"
+#include "../program/linereader.h"
+#include <string.h>
+
+
+//This function cuts the data into roughly equal pieces, moving each cut
+//forward so that it falls on a line beginning with '>'.  Chunks that would
+//be empty are not made.
+void splitFastgIntoChunks(const char * start, const char * end, int targetChunkCount,
+                          std::vector<FastgChunk> * chunks)
+{
+    chunks->clear();
+    if (targetChunkCount < 1)
+        targetChunkCount = 1;
+
+    long long totalSize = end - start;
+    const char * chunkStart = start;
+    for (int i = 1; i < targetChunkCount && chunkStart < end; ++i)
+    {
+        const char * cut = start + totalSize * i / targetChunkCount;
+        if (cut <= chunkStart)
+            continue;
+
+        //Move the cut to just after the next newline that is followed by '>'.
+        const char * searchFrom = cut - 1;
+        while (true)
+        {
+            const char * newline = static_cast<const char *>(memchr(searchFrom, '\n', end - searchFrom));
+            if (newline == 0 || newline + 1 >= end)
+            {
+                cut = end;
+                break;
+            }
+            cut = newline + 1;
+            if (*cut == '>')
+                break;
+            searchFrom = cut;
+        }
+
+        if (cut >= end)
+            break;
+        chunks->push_back(FastgChunk(chunkStart, cut));
+        chunkStart = cut;
+    }
+
+    if (chunkStart < end || chunks->empty())
+        chunks->push_back(FastgChunk(chunkStart, end));
+}
+
+
+//This function finds the given field of an underscore-delimited name, e.g.
+//field 3 of "EDGE_1_length_100_cov_5.5" is "100".
+static bool getUnderscoreField(const char * start, int length, int fieldIndex,
+                               const char ** fieldStart, int * fieldLength)
+{
+    const char * end = start + length;
+    const char * position = start;
+    for (int i = 0; i < fieldIndex; ++i)
+    {
+        position = static_cast<const char *>(memchr(position, '_', end - position));
+        if (position == 0)
+            return false;
+        ++position;
+    }
+
+    const char * fieldEnd = static_cast<const char *>(memchr(position, '_', end - position));
+    if (fieldEnd == 0)
+        fieldEnd = end;
+
+    *fieldStart = position;
+    *fieldLength = int(fieldEnd - position);
+    return true;
+}
+
+
+//This function parses a header line (without its '>'), which looks like:
+//EDGE_1_length_100_cov_5.5:EDGE_2_length_50_cov_3',EDGE_3_length_80_cov_4;
+//The node is added to the chunk and the edges are saved to be made later,
+//once all of the nodes exist.
+static bool parseFastgHeader(const char * line, int lineLength, FastgChunk & chunk)
+{
+    if (lineLength > 0 && line[lineLength - 1] == ';')
+        --lineLength;
+
+    const char * colon = static_cast<const char *>(memchr(line, ':', lineLength));
+    int nameLength = (colon != 0) ? int(colon - line) : lineLength;
+    if (nameLength == 0)
+        return false;
+
+    //A single quote as the last character indicates a negative node.
+    bool negativeNode = line[nameLength - 1] == '\'';
+    int unquotedNameLength = negativeNode ? nameLength - 1 : nameLength;
+
+    const char * numberField, * lengthField, * coverageField;
+    int numberFieldLength, lengthFieldLength, coverageFieldLength;
+    if (!getUnderscoreField(line, unquotedNameLength, 1, &numberField, &numberFieldLength) ||
+            !getUnderscoreField(line, unquotedNameLength, 3, &lengthField, &lengthFieldLength) ||
+            !getUnderscoreField(line, unquotedNameLength, 5, &coverageField, &coverageFieldLength))
+        return false;
+
+    FastgNodeRecord node;
+    node.m_number = parseLongLong(numberField, numberFieldLength);
+    node.m_length = int(parseLongLong(lengthField, lengthFieldLength));
+    node.m_coverage = parseDouble(coverageField, coverageFieldLength);
+    node.m_sequenceOffset = -1;
+    node.m_sequenceLength = 0;
+    if (negativeNode)
+        node.m_number *= -1;
+    chunk.m_nodes.push_back(node);
+
+    //The part after the colon is a comma-delimited list of edge nodes.
+    if (colon == 0)
+        return true;
+    const char * position = colon + 1;
+    const char * end = line + lineLength;
+    while (position < end)
+    {
+        const char * comma = static_cast<const char *>(memchr(position, ',', end - position));
+        const char * edgeNodeEnd = (comma != 0) ? comma : end;
+        int edgeNodeLength = int(edgeNodeEnd - position);
+
+        bool reverseComplement = false;
+        if (edgeNodeLength > 0 && position[edgeNodeLength - 1] == '\'')
+        {
+            reverseComplement = true;
+            --edgeNodeLength;
+        }
+
+        const char * edgeNodeNumberField;
+        int edgeNodeNumberFieldLength;
+        if (!getUnderscoreField(position, edgeNodeLength, 1, &edgeNodeNumberField, &edgeNodeNumberFieldLength))
+            return false;
+
+        long long edgeNodeNumber = parseLongLong(edgeNodeNumberField, edgeNodeNumberFieldLength);
+        if (reverseComplement)
+            edgeNodeNumber *= -1;
+
+        chunk.m_edgeStartingNodeNumbers.push_back(node.m_number);
+        chunk.m_edgeEndingNodeNumbers.push_back(edgeNodeNumber);
+
+        position = edgeNodeEnd + 1;
+    }
+
+    return true;
+}
+
+
+//This function is run on the thread pool, so it doesn't throw: problems are
+//recorded in the chunk's error flag instead.
+void parseFastgChunk(FastgChunk & chunk)
+{
+    const char * position = chunk.m_start;
+    const char * end = chunk.m_end;
+    FastgNodeRecord * node = 0;
+
+    //A node's sequence lines are joined here, and the sequence is packed
+    //once the node's last line has been read.
+    QByteArray sequence;
+
+    while (position < end)
+    {
+        const char * newline = static_cast<const char *>(memchr(position, '\n', end - position));
+        const char * lineEnd = (newline != 0) ? newline : end;
+        const char * line = position;
+        position = (newline != 0) ? newline + 1 : end;
+
+        //Whitespace (including the carriage return of Windows line endings)
+        //is trimmed from both ends of the line.  Sequence lines also have any
+        //whitespace within them left out.
+        while (line < lineEnd && (*line == ' ' || *line == '\t' || *line == '\r'))
+            ++line;
+        while (lineEnd > line && (lineEnd[-1] == ' ' || lineEnd[-1] == '\t' || lineEnd[-1] == '\r'))
+            --lineEnd;
+        int lineLength = int(lineEnd - line);
+
+        //If the line starts with a '>', then we are beginning a new node.
+        if (lineLength > 0 && line[0] == '>')
+        {
+            if (node != 0 && chunk.m_fileStart == 0)
+                node->m_sequence = PackedSequence(sequence);
+            sequence.truncate(0);
+
+            if (!parseFastgHeader(line + 1, lineLength - 1, chunk))
+            {
+                chunk.m_error = true;
+                return;
+            }
+            node = &chunk.m_nodes.back();
+        }
+
+        //Otherwise this line is part of the sequence for the last node.
+        else if (node != 0 && lineLength > 0)
+        {
+            if (chunk.m_fileStart == 0)
+                appendWithoutWhitespace(line, lineLength, &sequence);
+            else
+            {
+                if (node->m_sequenceOffset < 0)
+                    node->m_sequenceOffset = line - chunk.m_fileStart;
+                node->m_sequenceLength += countNonWhitespace(line, lineLength);
+            }
+        }
+    }
+
+    if (node != 0 && chunk.m_fileStart == 0)
+        node->m_sequence = PackedSequence(sequence);
+}
@@ -0,0 +1,61 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef FASTGPARSER_H
+#define FASTGPARSER_H
+
+#include <vector>
+#include <QByteArray>
+#include "packedsequence.h"
+
+struct FastgNodeRecord
+{
+    long long m_number;
+    int m_length;
+    double m_coverage;
+    PackedSequence m_sequence;
+    long long m_sequenceOffset;
+    int m_sequenceLength;
+};
+
+//A FastgChunk is a piece of a FASTG file that begins at a '>' (or at the
+//start of the file) and ends just before a '>'.  Each chunk is parsed on its
+//own, so chunks can be parsed in parallel, and the results are then merged in
+//chunk order so the graph is the same as if the file were read in one pass.
+//If m_fileStart is set, sequences aren't copied: instead each node records
+//its sequence's offset from m_fileStart, so it can be loaded on demand.
+struct FastgChunk
+{
+    FastgChunk() : m_start(0), m_end(0), m_fileStart(0), m_error(false) {}
+    FastgChunk(const char * start, const char * end) : m_start(start), m_end(end), m_fileStart(0), m_error(false) {}
+
+    const char * m_start;
+    const char * m_end;
+    const char * m_fileStart;
+
+    std::vector<FastgNodeRecord> m_nodes;
+    std::vector<long long> m_edgeStartingNodeNumbers;
+    std::vector<long long> m_edgeEndingNodeNumbers;
+    bool m_error;
+};
+
+void splitFastgIntoChunks(const char * start, const char * end, int targetChunkCount,
+                          std::vector<FastgChunk> * chunks);
+void parseFastgChunk(FastgChunk & chunk);
+
+#endif // FASTGPARSER_H
@@ -0,0 +1,193 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "gfaparser.h"
+#include "../program/linereader.h"
+#include <string.h>
+
+
+//This function cuts the data into roughly equal pieces, moving each cut
+//forward to the start of the next line.
+void splitGfaIntoChunks(const char * start, const char * end, int targetChunkCount,
+                        std::vector<GfaChunk> * chunks)
+{
+    chunks->clear();
+    if (targetChunkCount < 1)
+        targetChunkCount = 1;
+
+    long long totalSize = end - start;
+    const char * chunkStart = start;
+    for (int i = 1; i < targetChunkCount && chunkStart < end; ++i)
+    {
+        const char * cut = start + totalSize * i / targetChunkCount;
+        if (cut <= chunkStart)
+            continue;
+
+        const char * newline = static_cast<const char *>(memchr(cut - 1, '\n', end - cut + 1));
+        if (newline == 0 || newline + 1 >= end)
+            break;
+        cut = newline + 1;
+
+        chunks->push_back(GfaChunk(chunkStart, cut));
+        chunkStart = cut;
+    }
+
+    if (chunkStart < end || chunks->empty())
+        chunks->push_back(GfaChunk(chunkStart, end));
+}
+
+
+//This function splits a line into its tab-delimited fields.  It gives at
+//most maxFields fields and returns the number found.
+static int splitOnTabs(const char * line, int lineLength,
+                       const char ** fieldStarts, int * fieldLengths, int maxFields)
+{
+    const char * position = line;
+    const char * lineEnd = line + lineLength;
+    int fieldCount = 0;
+
+    while (fieldCount < maxFields)
+    {
+        const char * tab = static_cast<const char *>(memchr(position, '\t', lineEnd - position));
+        const char * fieldEnd = (tab != 0) ? tab : lineEnd;
+        fieldStarts[fieldCount] = position;
+        fieldLengths[fieldCount] = int(fieldEnd - position);
+        ++fieldCount;
+        if (tab == 0)
+            break;
+        position = tab + 1;
+    }
+
+    return fieldCount;
+}
+
+
+//This function parses an S line:
+//S <name> <sequence> [tags]
+//The sequence may be '*', in which case the length comes from the LN tag.
+//Coverage comes from the DP tag (depth) if there is one, or else from the
+//KC tag (k-mer count) divided by the length.
+static bool parseSegmentLine(const char * line, int lineLength, GfaChunk & chunk)
+{
+    const int maxFields = 32;
+    const char * fields[maxFields];
+    int fieldLengths[maxFields];
+    int fieldCount = splitOnTabs(line, lineLength, fields, fieldLengths, maxFields);
+    if (fieldCount < 3 || fieldLengths[1] == 0)
+        return false;
+
+    GfaSegmentRecord segment;
+    segment.m_name = QByteArray(fields[1], fieldLengths[1]);
+    bool noSequence = (fieldLengths[2] == 1 && fields[2][0] == '*');
+    segment.m_sequenceOffset = -1;
+    segment.m_length = noSequence ? 0 : fieldLengths[2];
+    if (!noSequence && chunk.m_fileStart != 0)
+        segment.m_sequenceOffset = fields[2] - chunk.m_fileStart;
+    else if (!noSequence)
+        segment.m_sequence = PackedSequence(fields[2], fieldLengths[2]);
+    segment.m_coverage = 0.0;
+
+    bool hasDepth = false;
+    long long kmerCount = -1;
+    for (int i = 3; i < fieldCount; ++i)
+    {
+        //Tags look like this: XX:T:value
+        if (fieldLengths[i] < 5 || fields[i][2] != ':' || fields[i][4] != ':')
+            continue;
+        const char * value = fields[i] + 5;
+        int valueLength = fieldLengths[i] - 5;
+
+        if (lineStartsWith(fields[i], fieldLengths[i], "DP:"))
+        {
+            segment.m_coverage = parseDouble(value, valueLength, &hasDepth);
+            if (!hasDepth)
+                segment.m_coverage = 0.0;
+        }
+        else if (lineStartsWith(fields[i], fieldLengths[i], "KC:"))
+            kmerCount = parseLongLong(value, valueLength);
+        else if (noSequence && lineStartsWith(fields[i], fieldLengths[i], "LN:"))
+            segment.m_length = int(parseLongLong(value, valueLength));
+    }
+
+    if (!hasDepth && kmerCount >= 0 && segment.m_length > 0)
+        segment.m_coverage = double(kmerCount) / segment.m_length;
+
+    chunk.m_segments.push_back(segment);
+    return true;
+}
+
+
+//This function parses an L line:
+//L <from name> <from orientation> <to name> <to orientation> <overlap>
+static bool parseLinkLine(const char * line, int lineLength, GfaChunk & chunk)
+{
+    const char * fields[5];
+    int fieldLengths[5];
+    if (splitOnTabs(line, lineLength, fields, fieldLengths, 5) < 5 ||
+            fieldLengths[2] != 1 || fieldLengths[4] != 1)
+        return false;
+
+    char fromOrientation = fields[2][0];
+    char toOrientation = fields[4][0];
+    if ((fromOrientation != '+' && fromOrientation != '-') ||
+            (toOrientation != '+' && toOrientation != '-'))
+        return false;
+
+    GfaLinkRecord link;
+    link.m_fromName = QByteArray(fields[1], fieldLengths[1]);
+    link.m_fromNegative = (fromOrientation == '-');
+    link.m_toName = QByteArray(fields[3], fieldLengths[3]);
+    link.m_toNegative = (toOrientation == '-');
+    chunk.m_links.push_back(link);
+    return true;
+}
+
+
+//This function is run on the thread pool, so it doesn't throw: problems are
+//recorded in the chunk's error flag instead.
+void parseGfaChunk(GfaChunk & chunk)
+{
+    const char * position = chunk.m_start;
+    const char * end = chunk.m_end;
+
+    while (position < end)
+    {
+        const char * newline = static_cast<const char *>(memchr(position, '\n', end - position));
+        const char * lineEnd = (newline != 0) ? newline : end;
+        const char * line = position;
+        position = (newline != 0) ? newline + 1 : end;
+
+        if (lineEnd > line && lineEnd[-1] == '\r')
+            --lineEnd;
+        int lineLength = int(lineEnd - line);
+        if (lineLength < 2 || line[1] != '\t')
+            continue;
+
+        bool parsed = true;
+        if (line[0] == 'S')
+            parsed = parseSegmentLine(line, lineLength, chunk);
+        else if (line[0] == 'L')
+            parsed = parseLinkLine(line, lineLength, chunk);
+
+        if (!parsed)
+        {
+            chunk.m_error = true;
+            return;
+        }
+    }
+}
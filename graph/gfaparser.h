@@ -0,0 +1,66 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef GFAPARSER_H
+#define GFAPARSER_H
+
+#include <vector>
+#include <QByteArray>
+#include "packedsequence.h"
+
+struct GfaSegmentRecord
+{
+    QByteArray m_name;
+    int m_length;
+    double m_coverage;
+    PackedSequence m_sequence;
+    long long m_sequenceOffset;
+};
+
+struct GfaLinkRecord
+{
+    QByteArray m_fromName;
+    bool m_fromNegative;
+    QByteArray m_toName;
+    bool m_toNegative;
+};
+
+//A GfaChunk is a piece of a GFA file made of whole lines.  As with FASTG
+//chunks, the chunks are parsed in parallel and then merged in file order.
+//Only S (segment) and L (link) records are used; the others are skipped.
+//If m_fileStart is set, segment sequences are given as offsets from it
+//instead of being copied.
+struct GfaChunk
+{
+    GfaChunk() : m_start(0), m_end(0), m_fileStart(0), m_error(false) {}
+    GfaChunk(const char * start, const char * end) : m_start(start), m_end(end), m_fileStart(0), m_error(false) {}
+
+    const char * m_start;
+    const char * m_end;
+    const char * m_fileStart;
+
+    std::vector<GfaSegmentRecord> m_segments;
+    std::vector<GfaLinkRecord> m_links;
+    bool m_error;
+};
+
+void splitGfaIntoChunks(const char * start, const char * end, int targetChunkCount,
+                        std::vector<GfaChunk> * chunks);
+void parseGfaChunk(GfaChunk & chunk);
+
+#endif // GFAPARSER_H
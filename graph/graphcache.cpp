@@ -0,0 +1,427 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "graphcache.h"
+#include "assemblygraph.h"
+#include "debruijnnode.h"
+#include "debruijnedge.h"
+#include "packedsequence.h"
+#include "sequencefile.h"
+#include "../program/graphloadworker.h"
+#include "../program/settings.h"
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+
+//The version must be increased whenever the layout of the cache changes, so
+//that old caches are ignored rather than misread.
+static const quint32 GRAPH_CACHE_VERSION = 7;
+static const char GRAPH_CACHE_MAGIC[8] = {'B', 'N', 'D', 'G', 'C', 'A', 'C', 'H'};
+static const quint32 GRAPH_CACHE_BYTE_ORDER_MARK = 0x01020304;
+
+//These say where a node record's sequence is.  For a sequence in the graph
+//file, the record's sequence offset is in the graph file and its length is
+//the number of bases.
+static const qint32 SEQUENCE_IN_CACHE = 0;
+static const qint32 SEQUENCE_IN_GRAPH_FILE = 1;
+static const qint32 SEQUENCE_IN_GRAPH_FILE_REVERSE_COMPLEMENT = 2;
+
+
+GraphCache::GraphCache(QString graphFileType, QString fullFileName) :
+    m_graphFileType(graphFileType), m_fullFileName(fullFileName),
+    m_cacheFile(getCacheFileName(fullFileName)), m_mapping(0)
+{
+}
+
+GraphCache::~GraphCache()
+{
+    if (m_mapping != 0)
+        m_cacheFile.unmap(m_mapping);
+    if (m_cacheFile.isOpen())
+        m_cacheFile.close();
+}
+
+
+QString GraphCache::getCacheFileName(QString fullFileName)
+{
+    return fullFileName + ".bandagecache";
+}
+
+
+//This function fills in the parts of the header that identify the graph
+//file the cache was made from.
+bool GraphCache::fillFingerprint(GraphCacheHeader * header)
+{
+    QFileInfo sourceInfo(m_fullFileName);
+    if (!sourceInfo.exists())
+        return false;
+
+    memset(header, 0, sizeof(GraphCacheHeader));
+    memcpy(header->m_magic, GRAPH_CACHE_MAGIC, sizeof(header->m_magic));
+    header->m_version = GRAPH_CACHE_VERSION;
+    header->m_byteOrderMark = GRAPH_CACHE_BYTE_ORDER_MARK;
+    if (m_graphFileType == "LastGraph")
+        header->m_graphFileType = 0;
+    else if (m_graphFileType == "FASTG")
+        header->m_graphFileType = 1;
+    else if (m_graphFileType == "GFA")
+        header->m_graphFileType = 3;
+    else
+        header->m_graphFileType = 2;
+    header->m_sourceSize = sourceInfo.size();
+    header->m_sourceModified = sourceInfo.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+
+//This function builds the graph from the cache, if there is a cache which
+//matches the graph file.  If it returns false, the graph may have been partly
+//built, so it should be cleaned up before the graph file is loaded normally.
+bool GraphCache::load(AssemblyGraph * graph, GraphLoadWorker * worker)
+{
+    GraphCacheHeader expected;
+    if (!fillFingerprint(&expected))
+        return false;
+
+    if (!m_cacheFile.open(QIODevice::ReadOnly))
+        return false;
+    qint64 cacheSize = m_cacheFile.size();
+    if (cacheSize < qint64(sizeof(GraphCacheHeader)))
+        return false;
+    m_mapping = m_cacheFile.map(0, cacheSize);
+    if (m_mapping == 0)
+        return false;
+
+    const GraphCacheHeader * header = reinterpret_cast<const GraphCacheHeader *>(m_mapping);
+    if (memcmp(header->m_magic, expected.m_magic, sizeof(header->m_magic)) != 0 ||
+            header->m_version != expected.m_version ||
+            header->m_byteOrderMark != expected.m_byteOrderMark ||
+            header->m_graphFileType != expected.m_graphFileType ||
+            header->m_sourceSize != expected.m_sourceSize ||
+            header->m_sourceModified != expected.m_sourceModified)
+        return false;
+
+    qint64 nodeTableOffset = sizeof(GraphCacheHeader);
+    qint64 edgeTableOffset = nodeTableOffset + header->m_nodeRecordCount * qint64(sizeof(GraphCacheNode));
+    qint64 sequenceOffset = edgeTableOffset + header->m_edgeRecordCount * qint64(sizeof(GraphCacheEdge));
+    qint64 segmentNameOffset = sequenceOffset + header->m_sequenceBytes;
+    if (header->m_nodeRecordCount <= 0 || header->m_edgeRecordCount < 0 || header->m_sequenceBytes < 0 ||
+            header->m_segmentNameBytes < 0 || segmentNameOffset + header->m_segmentNameBytes != cacheSize)
+        return false;
+
+    const GraphCacheNode * nodeRecords = reinterpret_cast<const GraphCacheNode *>(m_mapping + nodeTableOffset);
+    const GraphCacheEdge * edgeRecords = reinterpret_cast<const GraphCacheEdge *>(m_mapping + edgeTableOffset);
+    const char * sequences = reinterpret_cast<const char *>(m_mapping + sequenceOffset);
+    qint64 nodeRecordCount = header->m_nodeRecordCount;
+    qint64 edgeRecordCount = header->m_edgeRecordCount;
+    qint64 totalRecords = nodeRecordCount + edgeRecordCount;
+
+    graph->m_trinityGraph = header->m_trinityGraph != 0;
+
+    if (header->m_segmentNameBytes > 0)
+    {
+        const char * namesStart = reinterpret_cast<const char *>(m_mapping + segmentNameOffset);
+        const char * namesEnd = namesStart + header->m_segmentNameBytes;
+        if (namesEnd[-1] != '\n')
+            return false;
+        std::vector<QByteArray> segmentNames;
+        for (const char * nameStart = namesStart; nameStart < namesEnd; )
+        {
+            const char * nameEnd = static_cast<const char *>(memchr(nameStart, '\n', namesEnd - nameStart));
+            segmentNames.push_back(QByteArray(nameStart, int(nameEnd - nameStart)));
+            nameStart = nameEnd + 1;
+        }
+        graph->setSegmentNames(&segmentNames);
+    }
+
+    //The sequences aren't copied: each one is a PackedSequence over the
+    //mapping.
+    //The nodes are added in record order, so a record's index is also its
+    //node's index in the graph's node table.
+    DeBruijnNodeTable & nodes = graph->m_deBruijnGraphNodes;
+    nodes.reserve(int(nodeRecordCount));
+    for (qint64 i = 0; i < nodeRecordCount; ++i)
+    {
+        if (i % 10000 == 0 && !worker->reportProgress(i, totalRecords))
+            throw "load cancelled";
+
+        const GraphCacheNode & record = nodeRecords[i];
+        if (record.m_sequenceOffset < 0 || nodes.contains(record.m_number))
+            return false;
+
+        //Sequences in the graph file are read from it on demand, so a cache
+        //with any of them is only used when sequences are loaded on demand.
+        if (record.m_sequenceSource != SEQUENCE_IN_CACHE)
+        {
+            if (record.m_sequenceSource != SEQUENCE_IN_GRAPH_FILE &&
+                    record.m_sequenceSource != SEQUENCE_IN_GRAPH_FILE_REVERSE_COMPLEMENT)
+                return false;
+            if (graph->m_sequenceFile == 0)
+            {
+                if (g_settings->sequenceLoadingMode != LOAD_SEQUENCES_ON_DEMAND)
+                    return false;
+                graph->m_sequenceFile = new SequenceFile(m_fullFileName);
+                if (!graph->m_sequenceFile->open())
+                    return false;
+            }
+        }
+        else if (record.m_packedSequenceBytes < 0 ||
+                 record.m_sequenceOffset + record.m_packedSequenceBytes > header->m_sequenceBytes)
+            return false;
+
+        //A node whose sequence comes from its reverse complement has none
+        //stored.
+        PackedSequence sequence;
+        if (record.m_sequenceFromReverseComplement == 0 && record.m_sequenceSource == SEQUENCE_IN_CACHE)
+        {
+            bool sequenceOk;
+            sequence = PackedSequence::fromRawData(sequences + record.m_sequenceOffset,
+                                                   record.m_packedSequenceBytes,
+                                                   record.m_sequenceLength, &sequenceOk);
+            if (!sequenceOk)
+                return false;
+        }
+        DeBruijnNode * node = graph->m_nodePool.create(record.m_number, record.m_length, record.m_coverage, sequence);
+        node->m_sequenceFromReverseComplement = record.m_sequenceFromReverseComplement != 0;
+        if (record.m_sequenceSource != SEQUENCE_IN_CACHE)
+            node->m_sequenceFileIndex = graph->m_sequenceFile->addSequence(record.m_sequenceOffset, record.m_sequenceLength,
+                                                                           record.m_sequenceSource == SEQUENCE_IN_GRAPH_FILE_REVERSE_COMPLEMENT);
+        nodes.insert(node);
+    }
+
+    //Only one node of a reverse complement pair can take its sequence from
+    //the other.
+    for (qint64 i = 0; i < nodeRecordCount; ++i)
+    {
+        qint32 reverseComplement = nodeRecords[i].m_reverseComplement;
+        if (reverseComplement >= 0 && reverseComplement < nodeRecordCount)
+            nodes.at(int(i))->m_reverseComplement = nodes.at(reverseComplement);
+        else if (nodeRecords[i].m_sequenceFromReverseComplement != 0)
+            return false;
+        else
+            continue;
+
+        if (nodeRecords[i].m_sequenceFromReverseComplement != 0 &&
+                nodeRecords[reverseComplement].m_sequenceFromReverseComplement != 0)
+            return false;
+    }
+
+    //The edges are made in the order they were originally made, so each
+    //node's edges are in the same order as after a normal load.
+    graph->m_deBruijnGraphEdges.reserve(edgeRecordCount);
+    graph->m_deBruijnGraphEdgeIndex.reserve(int(edgeRecordCount));
+    for (qint64 i = 0; i < edgeRecordCount; ++i)
+    {
+        if (i % 10000 == 0 && !worker->reportProgress(nodeRecordCount + i, totalRecords))
+            throw "load cancelled";
+
+        const GraphCacheEdge & record = edgeRecords[i];
+        if (record.m_startingNode < 0 || record.m_startingNode >= nodeRecordCount ||
+                record.m_endingNode < 0 || record.m_endingNode >= nodeRecordCount ||
+                record.m_reverseComplement < 0 || record.m_reverseComplement >= edgeRecordCount)
+            return false;
+
+        DeBruijnNode * startingNode = nodes.at(int(record.m_startingNode));
+        DeBruijnNode * endingNode = nodes.at(int(record.m_endingNode));
+        DeBruijnEdge * edge = graph->m_edgePool.create(startingNode, endingNode);
+        graph->m_deBruijnGraphEdges.push_back(edge);
+        graph->m_deBruijnGraphEdgeIndex.insert(qMakePair(startingNode->m_number, endingNode->m_number), edge);
+    }
+
+    for (qint64 i = 0; i < edgeRecordCount; ++i)
+        graph->m_deBruijnGraphEdges[i]->m_reverseComplement = graph->m_deBruijnGraphEdges[edgeRecords[i].m_reverseComplement];
+
+    graph->m_nodeCount = int(header->m_nodeCount);
+    graph->m_edgeCount = int(header->m_edgeCount);
+    graph->m_totalLength = header->m_totalLength;
+    graph->m_shortestContig = header->m_shortestContig;
+    graph->m_longestContig = header->m_longestContig;
+    graph->m_meanCoverage = header->m_meanCoverage;
+    graph->m_firstQuartileCoverage = header->m_firstQuartileCoverage;
+    graph->m_medianCoverage = header->m_medianCoverage;
+    graph->m_thirdQuartileCoverage = header->m_thirdQuartileCoverage;
+    graph->m_n50 = header->m_n50;
+    graph->m_n90 = header->m_n90;
+    graph->m_l50 = int(header->m_l50);
+    graph->m_firstQuartileWeightedCoverage = header->m_firstQuartileWeightedCoverage;
+    graph->m_medianWeightedCoverage = header->m_medianWeightedCoverage;
+    graph->m_thirdQuartileWeightedCoverage = header->m_thirdQuartileWeightedCoverage;
+    graph->m_gcContent = header->m_gcContent;
+    graph->m_lengthHistogram.setCounts(header->m_lengthHistogram);
+    graph->m_coverageHistogram.setCounts(header->m_coverageHistogram);
+
+    return true;
+}
+
+
+//This function writes the cache for a graph that has just been loaded and
+//had its info determined.  The cache is written to a temporary file which
+//then replaces any old cache, so a partly written cache is never used.  If
+//the cache can't be written (e.g. the directory is read-only), nothing
+//happens.
+bool GraphCache::save(AssemblyGraph * graph)
+{
+    GraphCacheHeader header;
+    if (!fillFingerprint(&header))
+        return false;
+
+    int nodeRecordCount = graph->m_deBruijnGraphNodes.size();
+    int edgeRecordCount = int(graph->m_deBruijnGraphEdges.size());
+
+    //The node records are in the same order as the graph's node table, so a
+    //node's record index is its index in the table.
+    const DeBruijnNodeTable & nodes = graph->m_deBruijnGraphNodes;
+    std::vector<GraphCacheNode> nodeRecords;
+    nodeRecords.reserve(nodeRecordCount);
+    qint64 sequenceBytes = 0;
+
+    for (int i = 0; i < nodeRecordCount; ++i)
+    {
+        DeBruijnNode * node = nodes.at(i);
+
+        GraphCacheNode record;
+        memset(&record, 0, sizeof(record));
+        record.m_number = node->m_number;
+        record.m_coverage = node->m_coverage;
+        record.m_length = node->m_length;
+        record.m_sequenceFromReverseComplement = node->m_sequenceFromReverseComplement ? 1 : 0;
+        record.m_reverseComplement = -1;
+        if (node->m_reverseComplement != 0)
+            record.m_reverseComplement = nodes.indexOf(node->m_reverseComplement->m_number);
+
+        //A sequence loaded on demand isn't read to make the cache: its
+        //record gives where it is in the graph file instead, which stays
+        //right as long as the cache is used, since the graph file must be
+        //unchanged.  A sequence which comes from the node's reverse
+        //complement isn't stored at all.
+        //The graph isn't the main window's yet, so the sequence lengths are
+        //found from its own sequence file.
+        const DeBruijnNode * holder = node->m_sequenceFromReverseComplement ? node->m_reverseComplement : node;
+        if (holder->m_sequenceFileIndex >= 0)
+            record.m_sequenceLength = graph->m_sequenceFile->getSequenceLength(holder->m_sequenceFileIndex);
+        else
+            record.m_sequenceLength = holder->m_sequence.length();
+
+        if (node->m_sequenceFileIndex >= 0 && !node->m_sequenceFromReverseComplement)
+        {
+            record.m_sequenceSource = graph->m_sequenceFile->isReverseComplement(node->m_sequenceFileIndex) ?
+                        SEQUENCE_IN_GRAPH_FILE_REVERSE_COMPLEMENT : SEQUENCE_IN_GRAPH_FILE;
+            record.m_sequenceOffset = graph->m_sequenceFile->getSequenceOffset(node->m_sequenceFileIndex);
+        }
+        else
+        {
+            record.m_sequenceSource = SEQUENCE_IN_CACHE;
+            record.m_sequenceOffset = sequenceBytes;
+            record.m_packedSequenceBytes = node->m_sequence.data().size();
+            sequenceBytes += record.m_packedSequenceBytes;
+        }
+        nodeRecords.push_back(record);
+    }
+
+    QHash<DeBruijnEdge *, int> edgeIndices;
+    edgeIndices.reserve(edgeRecordCount);
+    for (int k = 0; k < edgeRecordCount; ++k)
+        edgeIndices.insert(graph->m_deBruijnGraphEdges[k], k);
+
+    std::vector<GraphCacheEdge> edgeRecords(edgeRecordCount);
+    for (int k = 0; k < edgeRecordCount; ++k)
+    {
+        DeBruijnEdge * edge = graph->m_deBruijnGraphEdges[k];
+        edgeRecords[k].m_startingNode = nodes.indexOf(edge->m_startingNode->m_number);
+        edgeRecords[k].m_endingNode = nodes.indexOf(edge->m_endingNode->m_number);
+        edgeRecords[k].m_reverseComplement = edgeIndices.value(edge->m_reverseComplement, k);
+        edgeRecords[k].m_padding = 0;
+    }
+
+    header.m_trinityGraph = graph->m_trinityGraph ? 1 : 0;
+    header.m_nodeRecordCount = nodeRecordCount;
+    header.m_edgeRecordCount = edgeRecordCount;
+    header.m_sequenceBytes = sequenceBytes;
+    header.m_segmentNameBytes = 0;
+    for (size_t k = 0; k < graph->m_segmentNames.size(); ++k)
+        header.m_segmentNameBytes += graph->m_segmentNames[k].size() + 1;
+    header.m_nodeCount = graph->m_nodeCount;
+    header.m_edgeCount = graph->m_edgeCount;
+    header.m_totalLength = graph->m_totalLength;
+    header.m_shortestContig = graph->m_shortestContig;
+    header.m_longestContig = graph->m_longestContig;
+    header.m_meanCoverage = graph->m_meanCoverage;
+    header.m_firstQuartileCoverage = graph->m_firstQuartileCoverage;
+    header.m_medianCoverage = graph->m_medianCoverage;
+    header.m_thirdQuartileCoverage = graph->m_thirdQuartileCoverage;
+    header.m_n50 = graph->m_n50;
+    header.m_n90 = graph->m_n90;
+    header.m_l50 = graph->m_l50;
+    header.m_firstQuartileWeightedCoverage = graph->m_firstQuartileWeightedCoverage;
+    header.m_medianWeightedCoverage = graph->m_medianWeightedCoverage;
+    header.m_thirdQuartileWeightedCoverage = graph->m_thirdQuartileWeightedCoverage;
+    header.m_gcContent = graph->m_gcContent;
+    std::copy(graph->m_lengthHistogram.getCounts().begin(), graph->m_lengthHistogram.getCounts().end(),
+              header.m_lengthHistogram);
+    std::copy(graph->m_coverageHistogram.getCounts().begin(), graph->m_coverageHistogram.getCounts().end(),
+              header.m_coverageHistogram);
+
+    QString cacheFileName = getCacheFileName(m_fullFileName);
+    QString temporaryFileName = cacheFileName + ".tmp";
+    QFile temporaryFile(temporaryFileName);
+    if (!temporaryFile.open(QIODevice::WriteOnly))
+        return false;
+
+    bool written = temporaryFile.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header));
+    if (written && nodeRecordCount > 0)
+    {
+        qint64 size = qint64(nodeRecordCount) * sizeof(GraphCacheNode);
+        written = temporaryFile.write(reinterpret_cast<const char *>(&nodeRecords[0]), size) == size;
+    }
+    if (written && edgeRecordCount > 0)
+    {
+        qint64 size = qint64(edgeRecordCount) * sizeof(GraphCacheEdge);
+        written = temporaryFile.write(reinterpret_cast<const char *>(&edgeRecords[0]), size) == size;
+    }
+    for (int k = 0; written && k < nodeRecordCount; ++k)
+    {
+        if (nodeRecords[k].m_sequenceSource != SEQUENCE_IN_CACHE)
+            continue;
+        const QByteArray & packedSequence = nodes.at(k)->m_sequence.data();
+        written = temporaryFile.write(packedSequence.constData(), packedSequence.size()) == packedSequence.size();
+    }
+    for (size_t k = 0; written && k < graph->m_segmentNames.size(); ++k)
+    {
+        const QByteArray & name = graph->m_segmentNames[k];
+        written = temporaryFile.write(name.constData(), name.size()) == name.size() &&
+                temporaryFile.write("\n", 1) == 1;
+    }
+    temporaryFile.close();
+
+    if (!written)
+    {
+        QFile::remove(temporaryFileName);
+        return false;
+    }
+
+    QFile::remove(cacheFileName);
+    if (!QFile::rename(temporaryFileName, cacheFileName))
+    {
+        QFile::remove(temporaryFileName);
+        return false;
+    }
+    return true;
+}
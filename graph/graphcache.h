@@ -0,0 +1,118 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef GRAPHCACHE_H
+#define GRAPHCACHE_H
+
+#include <QString>
+#include <QFile>
+#include <QtGlobal>
+#include "graphstatistics.h"
+
+class AssemblyGraph;
+class GraphLoadWorker;
+
+//The cache file starts with this header, followed by the node table, the
+//edge table, all of the node sequences (in their PackedSequence form) end to
+//end, except for those loaded on demand (whose place in the graph file is
+//given by their node record instead), and then the graph's GFA segment names, if it has them, each ended by a
+//newline.  It is
+//written in the machine's own byte order, as it is only a cache for the
+//machine that made it.
+struct GraphCacheHeader
+{
+    char m_magic[8];
+    quint32 m_version;
+    quint32 m_byteOrderMark;
+    qint32 m_graphFileType;
+    qint32 m_trinityGraph;
+    qint64 m_sourceSize;
+    qint64 m_sourceModified;
+
+    qint64 m_nodeRecordCount;
+    qint64 m_edgeRecordCount;
+    qint64 m_sequenceBytes;
+    qint64 m_segmentNameBytes;
+
+    qint64 m_nodeCount;
+    qint64 m_edgeCount;
+    qint64 m_totalLength;
+    qint64 m_shortestContig;
+    qint64 m_longestContig;
+    double m_meanCoverage;
+    double m_firstQuartileCoverage;
+    double m_medianCoverage;
+    double m_thirdQuartileCoverage;
+    qint64 m_n50;
+    qint64 m_n90;
+    qint64 m_l50;
+    double m_firstQuartileWeightedCoverage;
+    double m_medianWeightedCoverage;
+    double m_thirdQuartileWeightedCoverage;
+    double m_gcContent;
+    qint64 m_lengthHistogram[LENGTH_HISTOGRAM_BIN_COUNT];
+    qint64 m_coverageHistogram[COVERAGE_HISTOGRAM_BIN_COUNT];
+};
+
+struct GraphCacheNode
+{
+    qint64 m_number;
+    qint64 m_sequenceOffset;
+    double m_coverage;
+    qint32 m_length;
+    qint32 m_sequenceLength;
+    qint32 m_reverseComplement;
+    qint32 m_packedSequenceBytes;
+    qint32 m_sequenceFromReverseComplement;
+    qint32 m_sequenceSource;
+};
+
+struct GraphCacheEdge
+{
+    qint32 m_startingNode;
+    qint32 m_endingNode;
+    qint32 m_reverseComplement;
+    qint32 m_padding;
+};
+
+
+//This class reads and writes a binary copy of a loaded graph, kept next to
+//the graph file.  A cache is only used if the graph file's size and
+//modification time match the ones it was made from.  A loaded cache stays
+//memory-mapped, as the node sequences point directly into it.
+class GraphCache
+{
+public:
+    GraphCache(QString graphFileType, QString fullFileName);
+    ~GraphCache();
+
+    static QString getCacheFileName(QString fullFileName);
+
+    bool load(AssemblyGraph * graph, GraphLoadWorker * worker);
+    bool save(AssemblyGraph * graph);
+
+private:
+    QString m_graphFileType;
+    QString m_fullFileName;
+    QFile m_cacheFile;
+    uchar * m_mapping;
+
+    bool fillFingerprint(GraphCacheHeader * header);
+};
+
+#endif // GRAPHCACHE_H
@@ -24,7 +24,6 @@
 #include "../program/globals.h"
 #include "../program/settings.h"
 #include "debruijnnode.h"
-#include "ogdfnode.h"
 #include <QLineF>
 #include "graphicsitemnode.h"
 
@@ -18,9 +18,7 @@
 
 #include "graphicsitemnode.h"
 #include "debruijnnode.h"
-#include "ogdfnode.h"
 #include <QPainterPathStroker>
-#include "../graph/ogdfnode.h"
 #include "../program/settings.h"
 #include <QPainter>
 #include <QPen>
@@ -40,6 +38,7 @@
 #include "../blast/blasthitpart.h"
 #include "assemblygraph.h"
 #include <cmath>
+#include <algorithm>
 
 GraphicsItemNode::GraphicsItemNode(DeBruijnNode * deBruijnNode,
                                    ogdf::GraphAttributes * graphAttributes, QGraphicsItem * parent) :
@@ -49,22 +48,25 @@ GraphicsItemNode::GraphicsItemNode(DeBruijnNode * deBruijnNode,
 {
     setWidth();
 
-    OgdfNode * pathOgdfNode = deBruijnNode->m_ogdfNode;
-    if (pathOgdfNode != 0)
+    const std::vector<ogdf::node> & ogdfNodes = g_assemblyGraph->m_ogdfNodes;
+    if (deBruijnNode->inOgdf())
     {
-        for (size_t i = 0; i < pathOgdfNode->m_ogdfNodes.size(); ++i)
+        int end = deBruijnNode->m_ogdfNodeStart + deBruijnNode->m_ogdfNodeCount;
+        m_linePoints.reserve(deBruijnNode->m_ogdfNodeCount);
+        for (int i = deBruijnNode->m_ogdfNodeStart; i < end; ++i)
         {
-            ogdf::node ogdfNode = pathOgdfNode->m_ogdfNodes[i];
+            ogdf::node ogdfNode = ogdfNodes[i];
             QPointF point(graphAttributes->x(ogdfNode), graphAttributes->y(ogdfNode));
             m_linePoints.push_back(point);
         }
     }
     else
     {
-        pathOgdfNode = deBruijnNode->m_reverseComplement->m_ogdfNode;
-        for (int i = int(pathOgdfNode->m_ogdfNodes.size()) - 1; i >= 0; --i)
+        DeBruijnNode * pathNode = deBruijnNode->m_reverseComplement;
+        m_linePoints.reserve(pathNode->m_ogdfNodeCount);
+        for (int i = pathNode->m_ogdfNodeStart + pathNode->m_ogdfNodeCount - 1; i >= pathNode->m_ogdfNodeStart; --i)
         {
-            ogdf::node ogdfNode = pathOgdfNode->m_ogdfNodes[i];
+            ogdf::node ogdfNode = ogdfNodes[i];
             QPointF point(graphAttributes->x(ogdfNode), graphAttributes->y(ogdfNode));
             m_linePoints.push_back(point);
         }
@@ -264,7 +266,7 @@ void GraphicsItemNode::setNodeColour()
 
     case CUSTOM_COLOURS:
     {
-        m_colour = m_deBruijnNode->m_customColour;
+        m_colour = g_assemblyGraph->getNodeCustomColour(m_deBruijnNode);
         break;
     }
 
@@ -409,8 +411,8 @@ void GraphicsItemNode::mouseMoveEvent(QGraphicsSceneMouseEvent * event)
     for (size_t i = 0; i < nodesToMove.size(); ++i)
     {
         DeBruijnNode * node = nodesToMove[i]->m_deBruijnNode;
-        for (size_t j = 0; j < node->m_edges.size(); ++j)
-            edgesToFix.insert(node->m_edges[j]);
+        for (DeBruijnEdge * const * j = node->outEdgesBegin(); j != node->inEdgesEnd(); ++j)
+            edgesToFix.insert(*j);
     }
 
     for (std::set<DeBruijnEdge *>::iterator i = edgesToFix.begin(); i != edgesToFix.end(); ++i)
@@ -571,8 +573,9 @@ QString GraphicsItemNode::getNodeText()
 {
     QString nodeText;
 
-    if (g_settings->displayNodeCustomLabels && m_deBruijnNode->m_customLabel.length() > 0)
-        nodeText += m_deBruijnNode->m_customLabel + "\n";
+    QString customLabel = g_assemblyGraph->getNodeCustomLabel(m_deBruijnNode);
+    if (g_settings->displayNodeCustomLabels && customLabel.length() > 0)
+        nodeText += customLabel + "\n";
     if (g_settings->displayNodeNumbers)
         nodeText += m_deBruijnNode->getNodeNumberText(true) + "\n";
     if (g_settings->displayNodeLengths)
@@ -599,10 +602,7 @@ QColor GraphicsItemNode::getCoverageColour()
     double lowValue;
     double highValue;
     if (g_settings->autoCoverageValue)
-    {
-        lowValue = g_assemblyGraph->m_firstQuartileCoverage;
-        highValue = g_assemblyGraph->m_thirdQuartileCoverage;
-    }
+        g_assemblyGraph->getAutoCoverageValues(&lowValue, &highValue);
     else
     {
         lowValue = g_settings->lowCoverageValue;
@@ -633,7 +633,14 @@ QColor GraphicsItemNode::getCoverageColour()
 
 void GraphicsItemNode::setWidth()
 {
-    m_width = getNodeWidth(m_deBruijnNode->m_coverageRelativeToMeanDrawnCoverage, g_settings->coveragePower,
+    double coverageRelativeToMeanDrawnCoverage = m_deBruijnNode->m_coverageRelativeToMeanDrawnCoverage;
+
+    double coverageCap = g_assemblyGraph->getWidthCoverageCap();
+    double meanDrawnCoverage = g_assemblyGraph->getMeanDeBruijnGraphCoverage(true);
+    if (coverageCap >= 0.0 && meanDrawnCoverage > 0.0)
+        coverageRelativeToMeanDrawnCoverage = std::min(coverageRelativeToMeanDrawnCoverage, coverageCap / meanDrawnCoverage);
+
+    m_width = getNodeWidth(coverageRelativeToMeanDrawnCoverage, g_settings->coveragePower,
                            g_settings->coverageEffectOnWidth, g_settings->averageNodeWidth);
 }
 
@@ -0,0 +1,350 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "graphstatistics.h"
+#include "debruijnnodetable.h"
+#include "debruijnnode.h"
+#include "nodecolumns.h"
+#include <QtConcurrentMap>
+#include <QThread>
+#include <algorithm>
+#include <limits>
+#include <math.h>
+
+GraphStatistics::GraphStatistics() :
+    m_nodeCount(0), m_totalLength(0), m_shortestContig(0), m_longestContig(0),
+    m_n50(0), m_n90(0), m_l50(0), m_meanCoverage(0.0), m_firstQuartileCoverage(0.0),
+    m_medianCoverage(0.0), m_thirdQuartileCoverage(0.0), m_firstQuartileWeightedCoverage(0.0),
+    m_medianWeightedCoverage(0.0), m_thirdQuartileWeightedCoverage(0.0), m_gcContent(-1.0),
+    m_lengthHistogram(makeLengthHistogram()), m_coverageHistogram(makeCoverageHistogram())
+{
+}
+
+LogHistogram GraphStatistics::makeLengthHistogram()
+{
+    return LogHistogram(1.0, LENGTH_HISTOGRAM_DECADES, LENGTH_HISTOGRAM_BINS_PER_DECADE);
+}
+
+LogHistogram GraphStatistics::makeCoverageHistogram()
+{
+    return LogHistogram(0.01, COVERAGE_HISTOGRAM_DECADES, COVERAGE_HISTOGRAM_BINS_PER_DECADE);
+}
+
+
+struct WeightedValue
+{
+    double m_value;
+    long long m_weight;
+};
+
+struct LowerValue
+{
+    bool operator()(const WeightedValue & a, const WeightedValue & b) const {return a.m_value < b.m_value;}
+};
+
+struct HigherValue
+{
+    bool operator()(const WeightedValue & a, const WeightedValue & b) const {return a.m_value > b.m_value;}
+};
+
+
+//A StatisticsChunk is a run of consecutive nodes.  Each chunk is summed up
+//on its own thread and the chunks are then combined.
+struct StatisticsChunk
+{
+    const DeBruijnNodeTable * m_nodes;
+    const NodeColumns * m_columns;
+    int m_start;
+    int m_end;
+
+    int m_nodeCount;
+    long long m_totalLength;
+    long long m_shortestContig;
+    long long m_longestContig;
+    long double m_coverageSum;
+    long long m_coverageLength;
+    long long m_gcBases;
+    long long m_atBases;
+    bool m_sequencesOnDemand;
+    LogHistogram m_lengthHistogram;
+    LogHistogram m_coverageHistogram;
+
+    //Each chunk fills its own part of these arrays, starting at its offset.
+    size_t m_singleNodeOffset;
+    std::vector<WeightedValue> * m_singleNodeLengths;
+    std::vector<WeightedValue> * m_singleNodeCoverages;
+};
+
+
+//A reverse complement has the same GC content, so a node's bases are counted
+//from whichever of the pair holds the sequence.  A sequence loaded on demand
+//isn't counted, as that would mean reading the whole graph file again, so
+//this returns false for it.
+static bool countNodeBases(const DeBruijnNode * node, long long * gcBases, long long * atBases)
+{
+    const DeBruijnNode * holder = node->m_sequenceFromReverseComplement ? node->m_reverseComplement : node;
+    if (holder->m_sequenceFileIndex >= 0)
+        return false;
+    holder->m_sequence.countBases(gcBases, atBases);
+    return true;
+}
+
+
+static void countChunkSingleNodes(StatisticsChunk & chunk)
+{
+    const long long * numbers = chunk.m_columns->m_number.data();
+    chunk.m_nodeCount = 0;
+    for (int i = chunk.m_start; i < chunk.m_end; ++i)
+    {
+        if (numbers[i] > 0)
+            ++chunk.m_nodeCount;
+    }
+}
+
+
+static void computeChunkStatistics(StatisticsChunk & chunk)
+{
+    const long long * numbers = chunk.m_columns->m_number.data();
+    const int * lengths = chunk.m_columns->m_length.data();
+    const double * coverages = chunk.m_columns->m_coverage.data();
+
+    chunk.m_totalLength = 0;
+    chunk.m_shortestContig = std::numeric_limits<long long>::max();
+    chunk.m_longestContig = 0;
+    chunk.m_coverageSum = 0.0;
+    chunk.m_coverageLength = 0;
+    chunk.m_gcBases = 0;
+    chunk.m_atBases = 0;
+    chunk.m_sequencesOnDemand = false;
+    chunk.m_lengthHistogram = GraphStatistics::makeLengthHistogram();
+    chunk.m_coverageHistogram = GraphStatistics::makeCoverageHistogram();
+    size_t singleNodeIndex = chunk.m_singleNodeOffset;
+
+    for (int i = chunk.m_start; i < chunk.m_end; ++i)
+    {
+        long long nodeLength = lengths[i];
+        chunk.m_shortestContig = std::min(chunk.m_shortestContig, nodeLength);
+        chunk.m_longestContig = std::max(chunk.m_longestContig, nodeLength);
+        chunk.m_coverageSum += nodeLength * coverages[i];
+        chunk.m_coverageLength += nodeLength;
+        chunk.m_coverageHistogram.add(coverages[i]);
+
+        //Only positive nodes go into the single node statistics.
+        if (numbers[i] <= 0)
+            continue;
+
+        chunk.m_totalLength += nodeLength;
+        chunk.m_lengthHistogram.add(double(nodeLength));
+        WeightedValue & length = (*chunk.m_singleNodeLengths)[singleNodeIndex];
+        length.m_value = double(nodeLength);
+        length.m_weight = nodeLength;
+        WeightedValue & coverage = (*chunk.m_singleNodeCoverages)[singleNodeIndex];
+        coverage.m_value = coverages[i];
+        coverage.m_weight = nodeLength;
+        ++singleNodeIndex;
+        if (!chunk.m_sequencesOnDemand &&
+                !countNodeBases(chunk.m_nodes->at(i), &chunk.m_gcBases, &chunk.m_atBases))
+            chunk.m_sequencesOnDemand = true;
+    }
+}
+
+
+//This function gives the index of the value at which the running total of
+//weights, going through the values in sorted order, first reaches target.
+//Selection is used instead of a full sort: the values are only partitioned
+//as far as is needed, and everything before the returned index ends up
+//before it in sorted order.
+//The search can start from an index found by an earlier call with a lower
+//target, as everything before that index is already in place.  weightBefore
+//is then the total weight before that index.
+template <typename Compare>
+static size_t selectByWeight(std::vector<WeightedValue> * values, size_t start, long long weightBefore,
+                             long double target, Compare compare)
+{
+    size_t first = start;
+    size_t last = values->size();
+    while (last - first > 1)
+    {
+        size_t middle = first + (last - first) / 2;
+        std::nth_element(values->begin() + first, values->begin() + middle, values->begin() + last, compare);
+
+        long long lowerWeight = 0;
+        for (size_t i = first; i < middle; ++i)
+            lowerWeight += (*values)[i].m_weight;
+
+        if (weightBefore + lowerWeight >= target)
+            last = middle;
+        else if (weightBefore + lowerWeight + (*values)[middle].m_weight >= target)
+            return middle;
+        else
+        {
+            weightBefore += lowerWeight + (*values)[middle].m_weight;
+            first = middle + 1;
+        }
+    }
+    return first;
+}
+
+static long long weightBetween(const std::vector<WeightedValue> & values, size_t first, size_t last)
+{
+    long long weight = 0;
+    for (size_t i = first; i < last; ++i)
+        weight += values[i].m_weight;
+    return weight;
+}
+
+
+//This function gives the value at a fractional index of the values in sorted
+//order, interpolating between the two values on either side of it.  As with
+//selectByWeight, it can start from the whole part of an earlier, lower index.
+static double selectByFractionalIndex(std::vector<double> * values, size_t start, double index)
+{
+    if (values->empty())
+        return 0.0;
+    if (values->size() == 1)
+        return (*values)[0];
+
+    long long wholePart = (long long)(floor(index));
+    if (wholePart < 0)
+        wholePart = 0;
+    if (wholePart >= (long long)(values->size()) - 1)
+    {
+        std::nth_element(values->begin() + start, values->end() - 1, values->end());
+        return values->back();
+    }
+
+    std::nth_element(values->begin() + start, values->begin() + wholePart, values->end());
+    double piece1 = (*values)[wholePart];
+    double fractionalPart = index - wholePart;
+    if (fractionalPart <= 0.0)
+        return piece1;
+
+    //Everything after the whole part is no lower than it, so the next value
+    //in sorted order is the lowest of those.
+    double piece2 = *std::min_element(values->begin() + wholePart + 1, values->end());
+    return piece1 * (1.0 - fractionalPart) + piece2 * fractionalPart;
+}
+
+
+static double selectWeightedQuantile(std::vector<WeightedValue> * values, size_t * start,
+                                     long long * weightBefore, long long totalWeight, double fraction)
+{
+    if (values->empty() || totalWeight == 0)
+        return 0.0;
+    size_t index = selectByWeight(values, *start, *weightBefore, totalWeight * (long double)(fraction), LowerValue());
+    *weightBefore += weightBetween(*values, *start, index);
+    *start = index;
+    return (*values)[index].m_value;
+}
+
+
+void computeGraphStatistics(const DeBruijnNodeTable & nodes, const NodeColumns & columns,
+                            GraphStatistics * statistics)
+{
+    *statistics = GraphStatistics();
+    int columnSize = columns.size();
+    if (columnSize == 0)
+        return;
+
+    //There are a few chunks per thread so the work stays balanced when some
+    //nodes' sequences take longer to count than others.
+    int chunkCount = std::min(QThread::idealThreadCount() * 4, columnSize);
+    std::vector<StatisticsChunk> chunks(chunkCount);
+    for (int i = 0; i < chunkCount; ++i)
+    {
+        chunks[i].m_nodes = &nodes;
+        chunks[i].m_columns = &columns;
+        chunks[i].m_start = int((long long)(columnSize) * i / chunkCount);
+        chunks[i].m_end = int((long long)(columnSize) * (i + 1) / chunkCount);
+    }
+
+    //The positive nodes are counted first, so each chunk knows where its
+    //nodes go in the arrays of single node lengths and coverages.
+    QtConcurrent::blockingMap(chunks, countChunkSingleNodes);
+    size_t singleNodeCount = 0;
+    for (int i = 0; i < chunkCount; ++i)
+    {
+        chunks[i].m_singleNodeOffset = singleNodeCount;
+        singleNodeCount += chunks[i].m_nodeCount;
+    }
+    std::vector<WeightedValue> singleNodeLengths(singleNodeCount);
+    std::vector<WeightedValue> singleNodeCoverages(singleNodeCount);
+    for (int i = 0; i < chunkCount; ++i)
+    {
+        chunks[i].m_singleNodeLengths = &singleNodeLengths;
+        chunks[i].m_singleNodeCoverages = &singleNodeCoverages;
+    }
+    QtConcurrent::blockingMap(chunks, computeChunkStatistics);
+
+    long double coverageSum = 0.0;
+    long long coverageLength = 0;
+    long long gcBases = 0;
+    long long atBases = 0;
+    bool sequencesOnDemand = false;
+    statistics->m_shortestContig = std::numeric_limits<long long>::max();
+    for (int i = 0; i < chunkCount; ++i)
+    {
+        const StatisticsChunk & chunk = chunks[i];
+        statistics->m_nodeCount += chunk.m_nodeCount;
+        statistics->m_totalLength += chunk.m_totalLength;
+        statistics->m_shortestContig = std::min(statistics->m_shortestContig, chunk.m_shortestContig);
+        statistics->m_longestContig = std::max(statistics->m_longestContig, chunk.m_longestContig);
+        coverageSum += chunk.m_coverageSum;
+        coverageLength += chunk.m_coverageLength;
+        gcBases += chunk.m_gcBases;
+        atBases += chunk.m_atBases;
+        sequencesOnDemand = sequencesOnDemand || chunk.m_sequencesOnDemand;
+        statistics->m_lengthHistogram.merge(chunk.m_lengthHistogram);
+        statistics->m_coverageHistogram.merge(chunk.m_coverageHistogram);
+    }
+
+    if (coverageLength > 0)
+        statistics->m_meanCoverage = coverageSum / coverageLength;
+    if (!sequencesOnDemand && gcBases + atBases > 0)
+        statistics->m_gcContent = double(gcBases) / (gcBases + atBases);
+
+    //N50 is the length of the node which takes the total length of the
+    //longest nodes past half of the graph's total length, and L50 is how many
+    //nodes that takes.  N90 carries on from where N50 stopped.
+    long long totalLength = statistics->m_totalLength;
+    if (totalLength > 0)
+    {
+        size_t n50Index = selectByWeight(&singleNodeLengths, 0, 0, totalLength * 0.5L, HigherValue());
+        statistics->m_n50 = (long long)(singleNodeLengths[n50Index].m_value);
+        statistics->m_l50 = int(n50Index) + 1;
+
+        size_t n90Index = selectByWeight(&singleNodeLengths, n50Index, weightBetween(singleNodeLengths, 0, n50Index),
+                                         totalLength * 0.9L, HigherValue());
+        statistics->m_n90 = (long long)(singleNodeLengths[n90Index].m_value);
+    }
+
+    size_t start = 0;
+    long long weightBefore = 0;
+    statistics->m_firstQuartileWeightedCoverage = selectWeightedQuantile(&singleNodeCoverages, &start, &weightBefore, totalLength, 0.25);
+    statistics->m_medianWeightedCoverage = selectWeightedQuantile(&singleNodeCoverages, &start, &weightBefore, totalLength, 0.5);
+    statistics->m_thirdQuartileWeightedCoverage = selectWeightedQuantile(&singleNodeCoverages, &start, &weightBefore, totalLength, 0.75);
+
+    //The plain coverage quartiles are over every node.
+    std::vector<double> coverages(columns.m_coverage);
+    double firstQuartileIndex = coverages.size() / 4.0;
+    double medianIndex = coverages.size() / 2.0;
+    double thirdQuartileIndex = coverages.size() * 3.0 / 4.0;
+    statistics->m_firstQuartileCoverage = selectByFractionalIndex(&coverages, 0, firstQuartileIndex);
+    statistics->m_medianCoverage = selectByFractionalIndex(&coverages, size_t(floor(firstQuartileIndex)), medianIndex);
+    statistics->m_thirdQuartileCoverage = selectByFractionalIndex(&coverages, size_t(floor(medianIndex)), thirdQuartileIndex);
+}
@@ -0,0 +1,75 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef GRAPHSTATISTICS_H
+#define GRAPHSTATISTICS_H
+
+#include "loghistogram.h"
+
+class DeBruijnNodeTable;
+class NodeColumns;
+
+//The length histogram goes from 1 bp to 10 Gbp and the coverage histogram
+//from 0.01 to 10 million, each with 1 bin below the range.
+static const int LENGTH_HISTOGRAM_DECADES = 10;
+static const int LENGTH_HISTOGRAM_BINS_PER_DECADE = 20;
+static const int LENGTH_HISTOGRAM_BIN_COUNT = 1 + LENGTH_HISTOGRAM_DECADES * LENGTH_HISTOGRAM_BINS_PER_DECADE;
+static const int COVERAGE_HISTOGRAM_DECADES = 9;
+static const int COVERAGE_HISTOGRAM_BINS_PER_DECADE = 50;
+static const int COVERAGE_HISTOGRAM_BIN_COUNT = 1 + COVERAGE_HISTOGRAM_DECADES * COVERAGE_HISTOGRAM_BINS_PER_DECADE;
+
+//These are the statistics of a graph's nodes, which are found once when the
+//graph is loaded (and then kept in its cache).
+//The total length, N50, N90, L50, length-weighted coverage quartiles and GC
+//content are for single nodes, so node 5 and node -5 are counted once.  The
+//shortest and longest contigs, mean coverage and plain coverage quartiles
+//are over all nodes.
+//The GC content is -1 if the graph has no sequences or its sequences are
+//loaded on demand.
+//The length histogram is of single nodes and the coverage histogram is of
+//all nodes, to match the coverage quartiles.
+struct GraphStatistics
+{
+    GraphStatistics();
+
+    int m_nodeCount;
+    long long m_totalLength;
+    long long m_shortestContig;
+    long long m_longestContig;
+    long long m_n50;
+    long long m_n90;
+    int m_l50;
+    double m_meanCoverage;
+    double m_firstQuartileCoverage;
+    double m_medianCoverage;
+    double m_thirdQuartileCoverage;
+    double m_firstQuartileWeightedCoverage;
+    double m_medianWeightedCoverage;
+    double m_thirdQuartileWeightedCoverage;
+    double m_gcContent;
+    LogHistogram m_lengthHistogram;
+    LogHistogram m_coverageHistogram;
+
+    static LogHistogram makeLengthHistogram();
+    static LogHistogram makeCoverageHistogram();
+};
+
+void computeGraphStatistics(const DeBruijnNodeTable & nodes, const NodeColumns & columns,
+                            GraphStatistics * statistics);
+
+#endif // GRAPHSTATISTICS_H
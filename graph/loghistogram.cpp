@@ -0,0 +1,126 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "loghistogram.h"
+#include <algorithm>
+#include <math.h>
+
+LogHistogram::LogHistogram(double lowestValue, int decades, int binsPerDecade) :
+    m_lowestValue(lowestValue), m_binsPerDecade(binsPerDecade),
+    m_counts(1 + decades * binsPerDecade, 0)
+{
+}
+
+
+void LogHistogram::add(double value)
+{
+    int bin = 0;
+    if (value >= m_lowestValue)
+    {
+        bin = 1 + int(floor(log10(value / m_lowestValue) * m_binsPerDecade));
+        bin = std::min(bin, binCount() - 1);
+    }
+    ++m_counts[bin];
+    m_cumulativeCounts.clear();
+}
+
+
+//Only histograms made with the same bins can be merged.
+void LogHistogram::merge(const LogHistogram & other)
+{
+    for (int i = 0; i < binCount(); ++i)
+        m_counts[i] += other.m_counts[i];
+    m_cumulativeCounts.clear();
+}
+
+void LogHistogram::clear()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_cumulativeCounts.clear();
+}
+
+void LogHistogram::setCounts(const long long * counts)
+{
+    std::copy(counts, counts + binCount(), m_counts.begin());
+    m_cumulativeCounts.clear();
+}
+
+
+double LogHistogram::binStart(int bin) const
+{
+    if (bin == 0)
+        return 0.0;
+    return m_lowestValue * pow(10.0, double(bin - 1) / m_binsPerDecade);
+}
+
+double LogHistogram::binEnd(int bin) const
+{
+    return m_lowestValue * pow(10.0, double(bin) / m_binsPerDecade);
+}
+
+long long LogHistogram::total() const
+{
+    long long total = 0;
+    for (int i = 0; i < binCount(); ++i)
+        total += m_counts[i];
+    return total;
+}
+
+
+//This function gives the value below which the given percentage of the
+//values fall.  Within a bin, the values are taken to be spread evenly on the
+//log scale (or on a linear scale for the first bin, which starts at zero).
+double LogHistogram::getPercentile(double percentile) const
+{
+    if (m_cumulativeCounts.empty())
+    {
+        m_cumulativeCounts.resize(binCount());
+        long long cumulativeCount = 0;
+        for (int i = 0; i < binCount(); ++i)
+        {
+            cumulativeCount += m_counts[i];
+            m_cumulativeCounts[i] = cumulativeCount;
+        }
+    }
+
+    long long totalCount = m_cumulativeCounts.back();
+    if (totalCount == 0)
+        return 0.0;
+
+    double target = std::max(0.0, std::min(100.0, percentile)) / 100.0 * totalCount;
+
+    //The bin is the first whose running total reaches the target.  A target
+    //of zero gives the start of the first bin with anything in it.
+    int bin;
+    if (target <= 0.0)
+        bin = int(std::upper_bound(m_cumulativeCounts.begin(), m_cumulativeCounts.end(), 0LL) - m_cumulativeCounts.begin());
+    else
+        bin = int(std::lower_bound(m_cumulativeCounts.begin(), m_cumulativeCounts.end(), (long long)(ceil(target))) - m_cumulativeCounts.begin());
+    bin = std::min(bin, binCount() - 1);
+
+    long long countBefore = (bin == 0) ? 0 : m_cumulativeCounts[bin - 1];
+    double fraction = 0.0;
+    if (m_counts[bin] > 0)
+        fraction = std::max(0.0, std::min(1.0, (target - countBefore) / m_counts[bin]));
+
+    double start = binStart(bin);
+    double end = binEnd(bin);
+    if (bin == 0)
+        return start + (end - start) * fraction;
+    return start * pow(end / start, fraction);
+}
@@ -0,0 +1,59 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef LOGHISTOGRAM_H
+#define LOGHISTOGRAM_H
+
+#include <vector>
+
+//This is a histogram whose bins are of equal width on a log scale, for
+//values like node lengths and coverages which span many orders of magnitude.
+//The first bin holds everything below the lowest value (including zero) and
+//the last bin also holds everything above the highest value.
+//Percentiles are found from the bin counts, interpolating within a bin, so
+//they don't need the values themselves to be sorted.
+class LogHistogram
+{
+public:
+    LogHistogram(double lowestValue = 1.0, int decades = 1, int binsPerDecade = 1);
+
+    void add(double value);
+    void merge(const LogHistogram & other);
+    void clear();
+
+    int binCount() const {return int(m_counts.size());}
+    double binStart(int bin) const;
+    double binEnd(int bin) const;
+    long long binTotal(int bin) const {return m_counts[bin];}
+    long long total() const;
+    double getPercentile(double percentile) const;
+
+    const std::vector<long long> & getCounts() const {return m_counts;}
+    void setCounts(const long long * counts);
+
+private:
+    double m_lowestValue;
+    int m_binsPerDecade;
+    std::vector<long long> m_counts;
+
+    //The running totals are only made when a percentile is needed, and are
+    //thrown away whenever the counts change.
+    mutable std::vector<long long> m_cumulativeCounts;
+};
+
+#endif // LOGHISTOGRAM_H
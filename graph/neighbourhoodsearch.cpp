@@ -0,0 +1,287 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "neighbourhoodsearch.h"
+#include "debruijnnode.h"
+#include "debruijnedge.h"
+#include "debruijnnodetable.h"
+#include <QtConcurrentMap>
+#include <QThread>
+#include <algorithm>
+#include <limits>
+
+//Frontiers smaller than this are expanded on the calling thread, as it
+//isn't worth starting threads for them.
+static const size_t PARALLEL_FRONTIER_SIZE = 4096;
+
+//A FrontierChunk is a run of nodes from the frontier.  Each chunk lists the
+//unvisited neighbours of its nodes, reading the visited array but never
+//writing to it, so chunks can be expanded in parallel.
+struct FrontierChunk
+{
+    const DeBruijnNodeTable * m_nodes;
+    const std::vector<char> * m_visited;
+    const int * m_start;
+    const int * m_end;
+    std::vector<int> m_neighbours;
+};
+
+
+//A node's neighbours are the nodes at the other end of its edges, in either
+//direction.  A loop is in both of the node's edge ranges, so it is only
+//followed from the outgoing range.
+static void addUnvisitedNeighbours(const DeBruijnNode * node, const std::vector<char> & visited,
+                                   std::vector<int> * neighbours)
+{
+    for (DeBruijnEdge * const * i = node->outEdgesBegin(); i != node->outEdgesEnd(); ++i)
+    {
+        int neighbour = (*i)->m_endingNode->m_columnIndex;
+        if (!visited[neighbour])
+            neighbours->push_back(neighbour);
+    }
+    for (DeBruijnEdge * const * i = node->inEdgesBegin(); i != node->inEdgesEnd(); ++i)
+    {
+        const DeBruijnNode * startingNode = (*i)->m_startingNode;
+        if (startingNode == node)
+            continue;
+        int neighbour = startingNode->m_columnIndex;
+        if (!visited[neighbour])
+            neighbours->push_back(neighbour);
+    }
+}
+
+static void expandFrontierChunk(FrontierChunk & chunk)
+{
+    for (const int * i = chunk.m_start; i != chunk.m_end; ++i)
+        addUnvisitedNeighbours(chunk.m_nodes->at(*i), *chunk.m_visited, &chunk.m_neighbours);
+}
+
+
+//This function finds every node within nodeDistance edges of any of the
+//starting nodes (including the starting nodes themselves), following edges
+//in either direction.  The found nodes are given by their index in the node
+//table.
+//It is a breadth-first search from all of the starting nodes at once, so
+//each node is reached once, at its shortest distance.  Each step expands the
+//whole frontier, in chunks on the thread pool if the frontier is big, and
+//then the chunks' neighbours are merged in order, so the result doesn't
+//depend on the number of threads.
+void findNodesWithinDistance(const DeBruijnNodeTable & nodes, const std::vector<DeBruijnNode *> & startingNodes,
+                             int nodeDistance, std::vector<int> * foundNodes)
+{
+    foundNodes->clear();
+    std::vector<char> visited(nodes.size(), 0);
+
+    std::vector<int> frontier;
+    for (size_t i = 0; i < startingNodes.size(); ++i)
+    {
+        int index = startingNodes[i]->m_columnIndex;
+        if (visited[index])
+            continue;
+        visited[index] = 1;
+        frontier.push_back(index);
+    }
+    foundNodes->insert(foundNodes->end(), frontier.begin(), frontier.end());
+
+    std::vector<int> neighbours;
+    std::vector<FrontierChunk> chunks;
+    for (int distance = 0; distance < nodeDistance && !frontier.empty(); ++distance)
+    {
+        neighbours.clear();
+        if (frontier.size() < PARALLEL_FRONTIER_SIZE)
+        {
+            for (size_t i = 0; i < frontier.size(); ++i)
+                addUnvisitedNeighbours(nodes.at(frontier[i]), visited, &neighbours);
+        }
+        else
+        {
+            size_t chunkCount = std::min(size_t(QThread::idealThreadCount() * 4), frontier.size());
+            chunks.assign(chunkCount, FrontierChunk());
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                chunks[i].m_nodes = &nodes;
+                chunks[i].m_visited = &visited;
+                chunks[i].m_start = &frontier[0] + frontier.size() * i / chunkCount;
+                chunks[i].m_end = &frontier[0] + frontier.size() * (i + 1) / chunkCount;
+            }
+            QtConcurrent::blockingMap(chunks, expandFrontierChunk);
+            for (size_t i = 0; i < chunkCount; ++i)
+                neighbours.insert(neighbours.end(), chunks[i].m_neighbours.begin(), chunks[i].m_neighbours.end());
+        }
+
+        //A node can be the neighbour of more than one frontier node, so it is
+        //only added the first time.
+        frontier.clear();
+        for (size_t i = 0; i < neighbours.size(); ++i)
+        {
+            int neighbour = neighbours[i];
+            if (visited[neighbour])
+                continue;
+            visited[neighbour] = 1;
+            frontier.push_back(neighbour);
+        }
+        foundNodes->insert(foundNodes->end(), frontier.begin(), frontier.end());
+    }
+}
+
+
+
+
+//A RadixHeap is a priority queue for keys which never go below the last key
+//popped, as is the case for the distances in Dijkstra's algorithm.  Items
+//are kept in buckets by the highest bit in which their key differs from the
+//last key popped, so a push is a single append, and an item is only moved
+//to a lower bucket (at most 64 times) as the last key catches up with it.
+class RadixHeap
+{
+public:
+    RadixHeap() : m_lastKey(0), m_size(0) {}
+
+    bool empty() const {return m_size == 0;}
+
+    void push(unsigned long long key, int value)
+    {
+        m_buckets[bucketIndex(key)].push_back(Item(key, value));
+        ++m_size;
+    }
+
+    void pop(unsigned long long * key, int * value)
+    {
+        //If the lowest bucket is empty, the first non-empty bucket's smallest
+        //key becomes the last key, and that bucket's items are spread into
+        //the buckets below it.  Its smallest key will land in bucket 0.
+        if (m_buckets[0].empty())
+        {
+            int i = 1;
+            while (m_buckets[i].empty())
+                ++i;
+
+            std::vector<Item> & bucket = m_buckets[i];
+            unsigned long long smallestKey = bucket[0].first;
+            for (size_t j = 1; j < bucket.size(); ++j)
+                smallestKey = std::min(smallestKey, bucket[j].first);
+            m_lastKey = smallestKey;
+
+            m_redistribute.swap(bucket);
+            for (size_t j = 0; j < m_redistribute.size(); ++j)
+                m_buckets[bucketIndex(m_redistribute[j].first)].push_back(m_redistribute[j]);
+            m_redistribute.clear();
+        }
+
+        *key = m_buckets[0].back().first;
+        *value = m_buckets[0].back().second;
+        m_buckets[0].pop_back();
+        --m_size;
+    }
+
+private:
+    typedef std::pair<unsigned long long, int> Item;
+
+    std::vector<Item> m_buckets[65];
+    std::vector<Item> m_redistribute;
+    unsigned long long m_lastKey;
+    size_t m_size;
+
+    //Bucket 0 holds keys equal to the last key, and bucket b holds keys whose
+    //highest bit differing from the last key is bit b - 1.
+    int bucketIndex(unsigned long long key) const
+    {
+        unsigned long long difference = key ^ m_lastKey;
+        int index = 0;
+        for (int shift = 32; shift > 0; shift /= 2)
+        {
+            if (difference >> shift)
+            {
+                difference >>= shift;
+                index += shift;
+            }
+        }
+        return index + int(difference);
+    }
+};
+
+
+//This function finds every node whose sequence starts within basePairDistance
+//bases of any of the starting nodes (including the starting nodes
+//themselves), following edges in either direction.  The distance to a node
+//is the total length of the nodes passed through on the way, so neighbours
+//of a starting node are at distance 0, however long they are, and the
+//length of the found nodes themselves isn't counted.
+//It is Dijkstra's algorithm from all of the starting nodes at once, using
+//node lengths as weights and a radix heap as the priority queue.  Nodes
+//beyond the distance are never queued, so the search stops once the region
+//has been covered, without looking at the rest of the graph.
+void findNodesWithinBasePairs(const DeBruijnNodeTable & nodes, const std::vector<DeBruijnNode *> & startingNodes,
+                              long long basePairDistance, std::vector<int> * foundNodes)
+{
+    foundNodes->clear();
+    if (basePairDistance < 0)
+        return;
+    unsigned long long limit = basePairDistance;
+
+    //Nodes which haven't been reached have the maximum distance.  A node is
+    //settled when it is first popped, and later copies of it in the heap
+    //(from when a shorter distance was found) are skipped.
+    const unsigned long long unreached = std::numeric_limits<unsigned long long>::max();
+    std::vector<unsigned long long> distances(nodes.size(), unreached);
+    std::vector<char> settled(nodes.size(), 0);
+    std::vector<char> isStartingNode(nodes.size(), 0);
+    RadixHeap heap;
+
+    for (size_t i = 0; i < startingNodes.size(); ++i)
+    {
+        int index = startingNodes[i]->m_columnIndex;
+        if (isStartingNode[index])
+            continue;
+        isStartingNode[index] = 1;
+        distances[index] = 0;
+        heap.push(0, index);
+    }
+
+    while (!heap.empty())
+    {
+        unsigned long long distance;
+        int index;
+        heap.pop(&distance, &index);
+        if (settled[index] || distance > distances[index])
+            continue;
+        settled[index] = 1;
+        foundNodes->push_back(index);
+
+        //Leaving a starting node costs nothing, as the distance is measured
+        //from the ends of the starting nodes.
+        const DeBruijnNode * node = nodes.at(index);
+        unsigned long long neighbourDistance = distance;
+        if (!isStartingNode[index])
+            neighbourDistance += node->m_length;
+        if (neighbourDistance > limit)
+            continue;
+
+        for (DeBruijnEdge * const * i = node->outEdgesBegin(); i != node->inEdgesEnd(); ++i)
+        {
+            const DeBruijnEdge * edge = *i;
+            const DeBruijnNode * neighbour = (i < node->outEdgesEnd()) ? edge->m_endingNode : edge->m_startingNode;
+            int neighbourIndex = neighbour->m_columnIndex;
+            if (neighbourDistance < distances[neighbourIndex])
+            {
+                distances[neighbourIndex] = neighbourDistance;
+                heap.push(neighbourDistance, neighbourIndex);
+            }
+        }
+    }
+}
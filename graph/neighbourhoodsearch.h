@@ -0,0 +1,32 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef NEIGHBOURHOODSEARCH_H
+#define NEIGHBOURHOODSEARCH_H
+
+#include <vector>
+
+class DeBruijnNode;
+class DeBruijnNodeTable;
+
+void findNodesWithinDistance(const DeBruijnNodeTable & nodes, const std::vector<DeBruijnNode *> & startingNodes,
+                             int nodeDistance, std::vector<int> * foundNodes);
+void findNodesWithinBasePairs(const DeBruijnNodeTable & nodes, const std::vector<DeBruijnNode *> & startingNodes,
+                              long long basePairDistance, std::vector<int> * foundNodes);
+
+#endif // NEIGHBOURHOODSEARCH_H
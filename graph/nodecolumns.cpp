@@ -0,0 +1,117 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "nodecolumns.h"
+
+NodeColumns::NodeColumns()
+{
+    clearDrawnTotals();
+}
+
+
+void NodeColumns::clear()
+{
+    m_number.clear();
+    m_length.clear();
+    m_coverage.clear();
+    m_drawn.clear();
+    m_contiguityStatus.clear();
+    clearDrawnTotals();
+}
+
+
+void NodeColumns::clearDrawnTotals()
+{
+    m_drawnCount = 0;
+    m_drawnLength = 0;
+    m_drawnCoverageSum = 0.0;
+    m_drawnLengthCoverageSum = 0.0;
+    m_drawnCoverageMax = 0.0;
+    m_drawnCoverageMaxIsStale = false;
+}
+
+
+//This function changes a node's drawn status and updates the running totals
+//if it has changed.
+void NodeColumns::setDrawn(int index, bool drawn)
+{
+    if (bool(m_drawn[index]) == drawn)
+        return;
+    m_drawn[index] = drawn;
+
+    int length = m_length[index];
+    double coverage = m_coverage[index];
+    if (drawn)
+    {
+        ++m_drawnCount;
+        m_drawnLength += length;
+        m_drawnCoverageSum += coverage;
+        m_drawnLengthCoverageSum += (long double)(length) * coverage;
+        if (m_drawnCount == 1 || coverage > m_drawnCoverageMax)
+            m_drawnCoverageMax = coverage;
+        return;
+    }
+
+    //The totals are started again when the last drawn node is undrawn, so
+    //rounding errors don't build up over many redraws.
+    --m_drawnCount;
+    if (m_drawnCount == 0)
+    {
+        clearDrawnTotals();
+        return;
+    }
+    m_drawnLength -= length;
+    m_drawnCoverageSum -= coverage;
+    m_drawnLengthCoverageSum -= (long double)(length) * coverage;
+
+    //The maximum can't be taken back, so if the node had it, it is found
+    //again the next time it is needed.
+    if (coverage >= m_drawnCoverageMax)
+        m_drawnCoverageMaxIsStale = true;
+}
+
+
+double NodeColumns::getMeanDrawnCoverage() const
+{
+    if (m_drawnCount == 0)
+        return 0.0;
+    return m_drawnCoverageSum / m_drawnCount;
+}
+
+double NodeColumns::getMeanDrawnCoverageByLength() const
+{
+    if (m_drawnLength == 0)
+        return 0.0;
+    return m_drawnLengthCoverageSum / m_drawnLength;
+}
+
+double NodeColumns::getMaxDrawnCoverage()
+{
+    if (m_drawnCoverageMaxIsStale)
+    {
+        m_drawnCoverageMax = 0.0;
+        int nodeCount = size();
+        for (int i = 0; i < nodeCount; ++i)
+        {
+            if (m_drawn[i] && m_coverage[i] > m_drawnCoverageMax)
+                m_drawnCoverageMax = m_coverage[i];
+        }
+        m_drawnCoverageMaxIsStale = false;
+    }
+    return m_drawnCoverageMax;
+}
@@ -0,0 +1,65 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef NODECOLUMNS_H
+#define NODECOLUMNS_H
+
+#include <vector>
+#include "../program/globals.h"
+
+//This holds the node attributes that whole-graph scans look at, each in its
+//own array in the same order as the graph's node table.  Scanning an array
+//like this only touches the one attribute, not the whole of every node.
+//The numbers, lengths and coverages don't change after loading.  The drawn
+//and contiguity status columns are written by the nodes' setters, so they
+//stay the same as the nodes' own values.
+//Running totals are kept for the drawn nodes as they are drawn and undrawn,
+//so the drawn nodes' coverage can be found without a scan.
+class NodeColumns
+{
+public:
+    NodeColumns();
+
+    std::vector<long long> m_number;
+    std::vector<int> m_length;
+    std::vector<double> m_coverage;
+    std::vector<char> m_drawn;
+    std::vector<ContiguityStatus> m_contiguityStatus;
+
+    int size() const {return int(m_number.size());}
+    void clear();
+
+    void setDrawn(int index, bool drawn);
+    int getDrawnCount() const {return m_drawnCount;}
+    long long getDrawnLength() const {return m_drawnLength;}
+    double getMeanDrawnCoverage() const;
+    double getMeanDrawnCoverageByLength() const;
+    double getMaxDrawnCoverage();
+
+private:
+    int m_drawnCount;
+    long long m_drawnLength;
+    long double m_drawnCoverageSum;
+    long double m_drawnLengthCoverageSum;
+    double m_drawnCoverageMax;
+    bool m_drawnCoverageMaxIsStale;
+
+    void clearDrawnTotals();
+};
+
+#endif // NODECOLUMNS_H
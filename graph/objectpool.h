@@ -0,0 +1,101 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <utility>
+
+//This class makes objects in large blocks of memory instead of with a
+//separate new for each one.  Objects are placed one after another in the
+//current block, and when the pool is cleared, they are all destroyed and the
+//blocks freed together.
+//An object can be destroyed early with destroy(), in which case its place is
+//reused by the next object made.  This is only expected to be rare, so the
+//freed places are kept in a simple list.
+template <typename T>
+class ObjectPool
+{
+public:
+    ObjectPool(int objectsPerBlock = 4096) :
+        m_objectsPerBlock(objectsPerBlock), m_objectsInLastBlock(0) {}
+    ~ObjectPool() {clear();}
+
+    template <typename... Args>
+    T * create(Args &&... args)
+    {
+        void * place;
+        if (!m_freePlaces.empty())
+        {
+            place = m_freePlaces.back();
+            m_freePlaces.pop_back();
+        }
+        else
+        {
+            if (m_blocks.empty() || m_objectsInLastBlock == m_objectsPerBlock)
+            {
+                m_blocks.push_back(static_cast<T *>(::operator new(sizeof(T) * m_objectsPerBlock)));
+                m_objectsInLastBlock = 0;
+            }
+            place = m_blocks.back() + m_objectsInLastBlock;
+            ++m_objectsInLastBlock;
+        }
+        return new (place) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T * object)
+    {
+        if (object == 0)
+            return;
+        object->~T();
+        m_freePlaces.push_back(object);
+    }
+
+    void clear()
+    {
+        std::sort(m_freePlaces.begin(), m_freePlaces.end());
+        for (size_t i = 0; i < m_blocks.size(); ++i)
+        {
+            int objectCount = (i + 1 == m_blocks.size()) ? m_objectsInLastBlock : m_objectsPerBlock;
+            for (int j = 0; j < objectCount; ++j)
+            {
+                T * object = m_blocks[i] + j;
+                if (!std::binary_search(m_freePlaces.begin(), m_freePlaces.end(), object))
+                    object->~T();
+            }
+            ::operator delete(m_blocks[i]);
+        }
+        m_blocks.clear();
+        m_freePlaces.clear();
+        m_objectsInLastBlock = 0;
+    }
+
+private:
+    ObjectPool(const ObjectPool &);
+    ObjectPool & operator=(const ObjectPool &);
+
+    std::vector<T *> m_blocks;
+    std::vector<T *> m_freePlaces;
+    int m_objectsPerBlock;
+    int m_objectsInLastBlock;
+};
+
+#endif // OBJECTPOOL_H
@@ -0,0 +1,261 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "packedsequence.h"
+#include <QtGlobal>
+#include <vector>
+#include <string.h>
+
+//These tables are made once: one gives the two-bit code for each character
+//(4 for anything other than A, C, G or T in either case), one gives the four
+//bases for each packed byte and one gives how many of those four are G or C.
+struct PackingTables
+{
+    unsigned char m_codes[256];
+    char m_bases[256][4];
+    unsigned char m_gcCounts[256];
+
+    PackingTables()
+    {
+        memset(m_codes, 4, sizeof(m_codes));
+        m_codes['A'] = 0; m_codes['a'] = 0;
+        m_codes['C'] = 1; m_codes['c'] = 1;
+        m_codes['G'] = 2; m_codes['g'] = 2;
+        m_codes['T'] = 3; m_codes['t'] = 3;
+
+        const char * bases = "ACGT";
+        for (int i = 0; i < 256; ++i)
+        {
+            m_gcCounts[i] = 0;
+            for (int j = 0; j < 4; ++j)
+            {
+                int code = (i >> (j * 2)) & 3;
+                m_bases[i][j] = bases[code];
+                if (code == 1 || code == 2)
+                    ++m_gcCounts[i];
+            }
+        }
+    }
+};
+
+static const PackingTables & packingTables()
+{
+    static const PackingTables tables;
+    return tables;
+}
+
+//The run lists may not be aligned (e.g. when they are in a cache file), so
+//their values are copied in and out.
+static qint32 readRunValue(const char * position)
+{
+    qint32 value;
+    memcpy(&value, position, sizeof(value));
+    return value;
+}
+
+static void appendRunValues(QByteArray * data, const std::vector<qint32> & values)
+{
+    if (!values.empty())
+        data->append(reinterpret_cast<const char *>(&values[0]), int(values.size() * sizeof(qint32)));
+}
+
+
+PackedSequence::PackedSequence(const char * sequence, int length) :
+    m_length(length)
+{
+    if (m_length == 0)
+        return;
+
+    const PackingTables & tables = packingTables();
+    m_data = QByteArray(packedBaseBytes(m_length), '\0');
+    unsigned char * packed = reinterpret_cast<unsigned char *>(m_data.data());
+    const unsigned char * bases = reinterpret_cast<const unsigned char *>(sequence);
+
+    //Each run is added to or extended as the sequence is read, so a long
+    //stretch of Ns (or of lower case) is only one run.
+    std::vector<qint32> exceptionRuns;
+    std::vector<qint32> lowerCaseRuns;
+    for (int i = 0; i < m_length; ++i)
+    {
+        unsigned char base = bases[i];
+        if (base >= 'a' && base <= 'z')
+        {
+            if (!lowerCaseRuns.empty() && lowerCaseRuns[lowerCaseRuns.size() - 2] + lowerCaseRuns.back() == i)
+                ++lowerCaseRuns.back();
+            else
+            {
+                lowerCaseRuns.push_back(i);
+                lowerCaseRuns.push_back(1);
+            }
+            base -= 'a' - 'A';
+        }
+
+        unsigned char code = tables.m_codes[base];
+        if (code < 4)
+            packed[i >> 2] |= code << ((i & 3) * 2);
+        else
+        {
+            size_t runCount = exceptionRuns.size();
+            if (runCount > 0 && exceptionRuns[runCount - 1] == base &&
+                    exceptionRuns[runCount - 3] + exceptionRuns[runCount - 2] == i)
+                ++exceptionRuns[runCount - 2];
+            else
+            {
+                exceptionRuns.push_back(i);
+                exceptionRuns.push_back(1);
+                exceptionRuns.push_back(base);
+            }
+        }
+    }
+
+    if (exceptionRuns.empty() && lowerCaseRuns.empty())
+        return;
+
+    std::vector<qint32> runCounts;
+    runCounts.push_back(qint32(exceptionRuns.size() / 3));
+    runCounts.push_back(qint32(lowerCaseRuns.size() / 2));
+    appendRunValues(&m_data, runCounts);
+    appendRunValues(&m_data, exceptionRuns);
+    appendRunValues(&m_data, lowerCaseRuns);
+}
+
+
+//This function makes a PackedSequence over data which is already packed,
+//without copying it, so the data must outlive the PackedSequence.  If the
+//data isn't a valid packed sequence of the given length, ok is set to false
+//and an empty sequence is returned.
+PackedSequence PackedSequence::fromRawData(const char * data, int bytes, int length, bool * ok)
+{
+    PackedSequence sequence;
+    sequence.m_data = QByteArray::fromRawData(data, bytes);
+    sequence.m_length = length;
+
+    *ok = length >= 0 && sequence.runsAreValid();
+    if (!*ok)
+        return PackedSequence();
+    return sequence;
+}
+
+
+bool PackedSequence::runsAreValid() const
+{
+    long long runBytes = (long long)(m_data.size()) - packedBaseBytes(m_length);
+    if (runBytes == 0)
+        return true;
+    if (runBytes < 8)
+        return false;
+
+    const char * runs = m_data.constData() + packedBaseBytes(m_length);
+    qint32 exceptionRunCount = readRunValue(runs);
+    qint32 lowerCaseRunCount = readRunValue(runs + 4);
+    if (exceptionRunCount < 0 || lowerCaseRunCount < 0 ||
+            runBytes != 8 + 12LL * exceptionRunCount + 8LL * lowerCaseRunCount)
+        return false;
+
+    const char * run = runs + 8;
+    for (qint32 i = 0; i < exceptionRunCount + lowerCaseRunCount; ++i)
+    {
+        qint32 start = readRunValue(run);
+        qint32 runLength = readRunValue(run + 4);
+        if (start < 0 || runLength <= 0 || (long long)(start) + runLength > m_length)
+            return false;
+        run += (i < exceptionRunCount) ? 12 : 8;
+    }
+
+    return true;
+}
+
+
+QByteArray PackedSequence::unpack() const
+{
+    QByteArray sequence(m_length, '\0');
+    if (m_length > 0)
+        unpack(sequence.data());
+    return sequence;
+}
+
+
+//This function writes the sequence's m_length bases to destination.  The
+//bases are unpacked four at a time, and then the runs are written over them.
+void PackedSequence::unpack(char * destination) const
+{
+    const PackingTables & tables = packingTables();
+    const unsigned char * packed = reinterpret_cast<const unsigned char *>(m_data.constData());
+
+    int wholeBytes = m_length / 4;
+    for (int i = 0; i < wholeBytes; ++i)
+        memcpy(destination + i * 4, tables.m_bases[packed[i]], 4);
+    for (int i = wholeBytes * 4; i < m_length; ++i)
+        destination[i] = tables.m_bases[packed[wholeBytes]][i & 3];
+
+    if (m_data.size() == packedBaseBytes(m_length))
+        return;
+
+    const char * runs = m_data.constData() + packedBaseBytes(m_length);
+    qint32 exceptionRunCount = readRunValue(runs);
+    qint32 lowerCaseRunCount = readRunValue(runs + 4);
+    const char * run = runs + 8;
+
+    for (qint32 i = 0; i < exceptionRunCount; ++i, run += 12)
+        memset(destination + readRunValue(run), char(readRunValue(run + 8)), readRunValue(run + 4));
+
+    //Only letters are in lower case runs, so setting the lower case bit is
+    //all that is needed.
+    for (qint32 i = 0; i < lowerCaseRunCount; ++i, run += 8)
+    {
+        char * runStart = destination + readRunValue(run);
+        char * runEnd = runStart + readRunValue(run + 4);
+        for (char * base = runStart; base != runEnd; ++base)
+            *base |= 0x20;
+    }
+}
+
+
+//This function adds the number of the sequence's bases that are G or C to
+//gcBases and the number that are A or T to atBases, without unpacking it.
+//Bases in exception runs (e.g. Ns) are in neither count.  They are packed as
+//A, so they only need to be taken off the A/T count.
+void PackedSequence::countBases(long long * gcBases, long long * atBases) const
+{
+    const PackingTables & tables = packingTables();
+    const unsigned char * packed = reinterpret_cast<const unsigned char *>(m_data.constData());
+
+    long long gc = 0;
+    int wholeBytes = m_length / 4;
+    for (int i = 0; i < wholeBytes; ++i)
+        gc += tables.m_gcCounts[packed[i]];
+    for (int i = wholeBytes * 4; i < m_length; ++i)
+    {
+        int code = (packed[wholeBytes] >> ((i & 3) * 2)) & 3;
+        if (code == 1 || code == 2)
+            ++gc;
+    }
+
+    long long exceptionBases = 0;
+    if (m_data.size() != packedBaseBytes(m_length))
+    {
+        const char * runs = m_data.constData() + packedBaseBytes(m_length);
+        qint32 exceptionRunCount = readRunValue(runs);
+        const char * run = runs + 8;
+        for (qint32 i = 0; i < exceptionRunCount; ++i, run += 12)
+            exceptionBases += readRunValue(run + 4);
+    }
+
+    *gcBases += gc;
+    *atBases += m_length - gc - exceptionBases;
+}
@@ -0,0 +1,60 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef PACKEDSEQUENCE_H
+#define PACKEDSEQUENCE_H
+
+#include <QByteArray>
+
+//This class holds a nucleotide sequence in a quarter of the space of plain
+//text: A, C, G and T take two bits each.  Any other character (N or another
+//IUPAC code) is kept in a list of exception runs, and lower case is kept in
+//a list of lower case runs, so the sequence unpacks to exactly what was
+//packed.  Both lists are usually empty.
+//The packed bases and the run lists are in one QByteArray, so copying a
+//PackedSequence is as cheap as copying a QByteArray.  The layout is:
+//  the packed bases, four to a byte, first base in the lowest bits
+//  then, only if there are any runs:
+//  the exception run count and the lower case run count (qint32 each)
+//  each exception run: start, length and character (qint32 each)
+//  each lower case run: start and length (qint32 each)
+class PackedSequence
+{
+public:
+    PackedSequence() : m_length(0) {}
+    PackedSequence(const char * sequence, int length);
+    PackedSequence(const QByteArray & sequence) : PackedSequence(sequence.constData(), sequence.length()) {}
+
+    static PackedSequence fromRawData(const char * data, int bytes, int length, bool * ok);
+
+    int length() const {return m_length;}
+    bool isEmpty() const {return m_length == 0;}
+    const QByteArray & data() const {return m_data;}
+    QByteArray unpack() const;
+    void unpack(char * destination) const;
+    void countBases(long long * gcBases, long long * atBases) const;
+
+private:
+    QByteArray m_data;
+    int m_length;
+
+    static int packedBaseBytes(int length) {return (length + 3) / 4;}
+    bool runsAreValid() const;
+};
+
+#endif // PACKEDSEQUENCE_H
@@ -0,0 +1,92 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "readpositions.h"
+#include <algorithm>
+
+void ReadPositions::clear()
+{
+    std::vector<int>().swap(m_readIds);
+    std::vector<int>().swap(m_offsetsFromNodeStart);
+    std::vector<int>().swap(m_readStartCoords);
+    std::vector<size_t>().swap(m_groupStarts);
+    m_nodeGroups.clear();
+}
+
+
+//This function begins a new group of reads for a node.  The reads that
+//follow (added with addRead) belong to this node until the next call.
+//Each node's reads must be in one group, so it returns false if the node
+//already has one.
+bool ReadPositions::startNode(long long nodeNumber, int readCount)
+{
+    if (m_nodeGroups.contains(nodeNumber))
+        return false;
+    m_nodeGroups.insert(nodeNumber, int(m_groupStarts.size()));
+    m_groupStarts.push_back(m_readIds.size());
+
+    size_t newSize = m_readIds.size() + readCount;
+    if (newSize > m_readIds.capacity())
+    {
+        //Grow geometrically so that many small nodes don't each
+        //cause a reallocation.
+        size_t newCapacity = std::max(newSize, m_readIds.capacity() * 3 / 2);
+        m_readIds.reserve(newCapacity);
+        m_offsetsFromNodeStart.reserve(newCapacity);
+        m_readStartCoords.reserve(newCapacity);
+    }
+
+    return true;
+}
+
+
+void ReadPositions::addRead(int readId, int offsetFromNodeStart, int readStartCoord)
+{
+    m_readIds.push_back(readId);
+    m_offsetsFromNodeStart.push_back(offsetFromNodeStart);
+    m_readStartCoords.push_back(readStartCoord);
+}
+
+
+int ReadPositions::getReadCount(long long nodeNumber) const
+{
+    size_t first, last;
+    if (!getReadRange(nodeNumber, &first, &last))
+        return 0;
+    return int(last - first);
+}
+
+
+//This function gives the indices into the read arrays for the given node's
+//reads: first is inclusive and last is exclusive.  It returns false if the
+//node has no reads.
+bool ReadPositions::getReadRange(long long nodeNumber, size_t * first, size_t * last) const
+{
+    QHash<long long, int>::const_iterator i = m_nodeGroups.constFind(nodeNumber);
+    if (i == m_nodeGroups.constEnd())
+        return false;
+
+    size_t group = size_t(i.value());
+    *first = m_groupStarts[group];
+    if (group + 1 < m_groupStarts.size())
+        *last = m_groupStarts[group + 1];
+    else
+        *last = m_readIds.size();
+
+    return true;
+}
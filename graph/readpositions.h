@@ -0,0 +1,50 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef READPOSITIONS_H
+#define READPOSITIONS_H
+
+#include <vector>
+#include <QHash>
+
+//This class holds the short read positions from the NR records of a
+//LastGraph file.  Rather than keeping the text, each read is stored as
+//three integers in parallel arrays, with the reads for each node stored
+//contiguously.
+class ReadPositions
+{
+public:
+    ReadPositions() {}
+
+    std::vector<int> m_readIds;
+    std::vector<int> m_offsetsFromNodeStart;
+    std::vector<int> m_readStartCoords;
+
+    void clear();
+    bool isEmpty() const {return m_readIds.empty();}
+    bool startNode(long long nodeNumber, int readCount);
+    void addRead(int readId, int offsetFromNodeStart, int readStartCoord);
+    int getReadCount(long long nodeNumber) const;
+    bool getReadRange(long long nodeNumber, size_t * first, size_t * last) const;
+
+private:
+    QHash<long long, int> m_nodeGroups;
+    std::vector<size_t> m_groupStarts;
+};
+
+#endif // READPOSITIONS_H
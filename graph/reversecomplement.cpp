@@ -0,0 +1,283 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "reversecomplement.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define REVERSE_COMPLEMENT_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+//GCC and Clang need to be told which functions may use SSSE3 and AVX2, so
+//the rest of the program can still run on CPUs without them.
+#if defined(REVERSE_COMPLEMENT_X86) && defined(__GNUC__)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+
+
+//Every letter that has a complement is found by its low five bits, which
+//are the same in upper and lower case.  The complement's low five bits are
+//given here, or 0 for letters which aren't IUPAC codes.
+static const char COMPLEMENT_CODES[32] = {
+    0,
+    'T' & 0x1F, //A
+    'V' & 0x1F, //B
+    'G' & 0x1F, //C
+    'H' & 0x1F, //D
+    0, 0,       //E, F
+    'C' & 0x1F, //G
+    'D' & 0x1F, //H
+    0, 0,       //I, J
+    'M' & 0x1F, //K
+    0,          //L
+    'K' & 0x1F, //M
+    'N' & 0x1F, //N
+    0, 0, 0,    //O, P, Q
+    'Y' & 0x1F, //R
+    'S' & 0x1F, //S
+    'A' & 0x1F, //T
+    0,          //U
+    'B' & 0x1F, //V
+    'W' & 0x1F, //W
+    0,          //X
+    'R' & 0x1F, //Y
+    0, 0, 0, 0, 0, 0};
+
+
+//This table gives the complement of every character, or 0 for characters
+//which are left out.
+struct ComplementTable
+{
+    char m_complements[256];
+
+    ComplementTable()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            char character = char(i);
+            bool letter = (character >= 'A' && character <= 'Z') || (character >= 'a' && character <= 'z');
+            if (letter && COMPLEMENT_CODES[i & 0x1F] != 0)
+                m_complements[i] = char((i & 0xE0) | COMPLEMENT_CODES[i & 0x1F]);
+            else if (character == '.' || character == '-' || character == '?')
+                m_complements[i] = character;
+            else
+                m_complements[i] = 0;
+        }
+    }
+};
+
+static const ComplementTable & complementTable()
+{
+    static const ComplementTable table;
+    return table;
+}
+
+
+//This works one base at a time and is always correct, so it is used when
+//the CPU has no vector instructions and for sequences with characters that
+//are left out.
+static int reverseComplementScalar(const char * sequence, int length, char * destination)
+{
+    const char * complements = complementTable().m_complements;
+    char * position = destination;
+    for (int i = length - 1; i >= 0; --i)
+    {
+        char complement = complements[(unsigned char)(sequence[i])];
+        if (complement != 0)
+            *position++ = complement;
+    }
+    return int(position - destination);
+}
+
+
+//The vector versions only write whole sequences: if they find a character
+//which should be left out, they return false and the scalar version is used
+//instead.  The last few bases, which don't fill a vector, are done one at a
+//time.
+static bool reverseComplementTail(const char * sequence, int start, int length, char * destination)
+{
+    const char * complements = complementTable().m_complements;
+    for (int i = start; i < length; ++i)
+    {
+        char complement = complements[(unsigned char)(sequence[i])];
+        if (complement == 0)
+            return false;
+        destination[length - 1 - i] = complement;
+    }
+    return true;
+}
+
+
+#ifdef REVERSE_COMPLEMENT_X86
+
+//Each block of bases is complemented by looking up the low five bits of each
+//base in COMPLEMENT_CODES (with two 16-entry shuffles) and putting the case
+//bits back.  Punctuation is kept as it is.  The block is then reversed and
+//written to the other end of the destination.
+TARGET_SSSE3 static bool reverseComplementSsse3(const char * sequence, int length, char * destination)
+{
+    const __m128i lowCodes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(COMPLEMENT_CODES));
+    const __m128i highCodes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(COMPLEMENT_CODES + 16));
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i lowFiveBits = _mm_set1_epi8(0x1F);
+    const __m128i caseBits = _mm_set1_epi8(char(0xE0));
+    const __m128i fifteen = _mm_set1_epi8(15);
+    const __m128i lowerCaseBit = _mm_set1_epi8(0x20);
+    const __m128i beforeA = _mm_set1_epi8('a' - 1);
+    const __m128i afterZ = _mm_set1_epi8('z' + 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i dash = _mm_set1_epi8('-');
+    const __m128i question = _mm_set1_epi8('?');
+
+    int i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i bases = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sequence + i));
+
+        __m128i index = _mm_and_si128(bases, lowFiveBits);
+        __m128i useHigh = _mm_cmpgt_epi8(index, fifteen);
+        __m128i code = _mm_or_si128(_mm_and_si128(useHigh, _mm_shuffle_epi8(highCodes, index)),
+                                    _mm_andnot_si128(useHigh, _mm_shuffle_epi8(lowCodes, index)));
+
+        __m128i folded = _mm_or_si128(bases, lowerCaseBit);
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(folded, beforeA), _mm_cmplt_epi8(folded, afterZ));
+        __m128i complementable = _mm_andnot_si128(_mm_cmpeq_epi8(code, zero), letter);
+        __m128i punctuation = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bases, dot), _mm_cmpeq_epi8(bases, dash)),
+                                           _mm_cmpeq_epi8(bases, question));
+        if (_mm_movemask_epi8(_mm_or_si128(complementable, punctuation)) != 0xFFFF)
+            return false;
+
+        __m128i complement = _mm_or_si128(_mm_and_si128(bases, caseBits), code);
+        __m128i result = _mm_or_si128(_mm_and_si128(complementable, complement),
+                                      _mm_andnot_si128(complementable, bases));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + length - i - 16),
+                         _mm_shuffle_epi8(result, reverse));
+    }
+
+    return reverseComplementTail(sequence, i, length, destination);
+}
+
+
+//This is the same as the SSSE3 version, but with 32 bases at a time.  The
+//shuffles work within each 16-byte half, so reversing a block also needs
+//the halves swapped.
+TARGET_AVX2 static bool reverseComplementAvx2(const char * sequence, int length, char * destination)
+{
+    const __m256i lowCodes = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(COMPLEMENT_CODES)));
+    const __m256i highCodes = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(COMPLEMENT_CODES + 16)));
+    const __m256i reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                             15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i lowFiveBits = _mm256_set1_epi8(0x1F);
+    const __m256i caseBits = _mm256_set1_epi8(char(0xE0));
+    const __m256i fifteen = _mm256_set1_epi8(15);
+    const __m256i lowerCaseBit = _mm256_set1_epi8(0x20);
+    const __m256i beforeA = _mm256_set1_epi8('a' - 1);
+    const __m256i z = _mm256_set1_epi8('z');
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i dot = _mm256_set1_epi8('.');
+    const __m256i dash = _mm256_set1_epi8('-');
+    const __m256i question = _mm256_set1_epi8('?');
+
+    int i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i bases = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sequence + i));
+
+        __m256i index = _mm256_and_si256(bases, lowFiveBits);
+        __m256i useHigh = _mm256_cmpgt_epi8(index, fifteen);
+        __m256i code = _mm256_blendv_epi8(_mm256_shuffle_epi8(lowCodes, index),
+                                          _mm256_shuffle_epi8(highCodes, index), useHigh);
+
+        __m256i folded = _mm256_or_si256(bases, lowerCaseBit);
+        __m256i letter = _mm256_andnot_si256(_mm256_cmpgt_epi8(folded, z), _mm256_cmpgt_epi8(folded, beforeA));
+        __m256i complementable = _mm256_andnot_si256(_mm256_cmpeq_epi8(code, zero), letter);
+        __m256i punctuation = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bases, dot), _mm256_cmpeq_epi8(bases, dash)),
+                                              _mm256_cmpeq_epi8(bases, question));
+        if (_mm256_movemask_epi8(_mm256_or_si256(complementable, punctuation)) != -1)
+            return false;
+
+        __m256i complement = _mm256_or_si256(_mm256_and_si256(bases, caseBits), code);
+        __m256i result = _mm256_blendv_epi8(bases, complement, complementable);
+        result = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(result, reverse), 0x4E);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + length - i - 32), result);
+    }
+
+    return reverseComplementTail(sequence, i, length, destination);
+}
+
+
+static bool cpuSupports(bool avx2)
+{
+#ifdef _MSC_VER
+    int registers[4];
+    __cpuid(registers, 0);
+    int highestFunction = registers[0];
+    if (highestFunction < 1)
+        return false;
+
+    __cpuid(registers, 1);
+    bool ssse3 = (registers[2] & (1 << 9)) != 0;
+    if (!avx2)
+        return ssse3;
+
+    //AVX2 also needs the operating system to save the AVX registers.
+    bool osSavesAvx = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+    if (!osSavesAvx || highestFunction < 7)
+        return false;
+    __cpuidex(registers, 7, 0);
+    return (registers[1] & (1 << 5)) != 0;
+#else
+    if (avx2)
+        return __builtin_cpu_supports("avx2");
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+#endif // REVERSE_COMPLEMENT_X86
+
+
+typedef bool (*VectorKernel)(const char *, int, char *);
+
+static VectorKernel chooseVectorKernel()
+{
+#ifdef REVERSE_COMPLEMENT_X86
+    if (cpuSupports(true))
+        return reverseComplementAvx2;
+    if (cpuSupports(false))
+        return reverseComplementSsse3;
+#endif
+    return 0;
+}
+
+
+int reverseComplementSequence(const char * sequence, int length, char * destination)
+{
+    static const VectorKernel vectorKernel = chooseVectorKernel();
+
+    if (vectorKernel != 0 && vectorKernel(sequence, length, destination))
+        return length;
+    return reverseComplementScalar(sequence, length, destination);
+}
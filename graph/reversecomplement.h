@@ -0,0 +1,31 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef REVERSECOMPLEMENT_H
+#define REVERSECOMPLEMENT_H
+
+//This function writes the reverse complement of a nucleotide sequence to
+//destination, which must have room for length bases.  IUPAC codes are
+//complemented and case is kept.  '.', '-' and '?' are kept as they are, and
+//any other character is left out, so the number of bases written is
+//returned.
+//Where the CPU supports them, SSSE3 or AVX2 instructions are used to do
+//16 or 32 bases at a time.  The choice is made when it is first called.
+int reverseComplementSequence(const char * sequence, int length, char * destination);
+
+#endif // REVERSECOMPLEMENT_H
@@ -0,0 +1,142 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "sequencefile.h"
+#include "reversecomplement.h"
+#include "../program/linereader.h"
+#include <QMutexLocker>
+
+SequenceFile::SequenceFile(QString fullFileName) :
+    m_file(fullFileName), m_mapping(0), m_fileSize(0)
+{
+}
+
+SequenceFile::~SequenceFile()
+{
+    if (m_mapping != 0)
+        m_file.unmap(m_mapping);
+}
+
+
+bool SequenceFile::open()
+{
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    m_fileSize = m_file.size();
+    if (m_fileSize > 0)
+        m_mapping = m_file.map(0, m_fileSize);
+
+    //If the file can't be mapped, sequences are read with ordinary file
+    //reads instead.
+    return true;
+}
+
+
+//Sequences are added while the graph is loaded, which happens on one thread.
+//A node made as the reverse complement of another node shares that node's
+//place in the file.
+int SequenceFile::addSequence(long long offset, int length, bool reverseComplement)
+{
+    SequenceLocation location;
+    location.m_offset = offset;
+    location.m_length = length;
+    location.m_reverseComplement = reverseComplement;
+    m_sequences.push_back(location);
+    return int(m_sequences.size()) - 1;
+}
+
+int SequenceFile::addReverseComplement(int index)
+{
+    const SequenceLocation & location = m_sequences[index];
+    return addSequence(location.m_offset, location.m_length, !location.m_reverseComplement);
+}
+
+
+QByteArray SequenceFile::getSequence(int index)
+{
+    const SequenceLocation & location = m_sequences[index];
+    QByteArray sequence = read(location.m_offset, location.m_length);
+    if (!location.m_reverseComplement)
+        return sequence;
+
+    QByteArray reverseComplement(sequence.length(), Qt::Uninitialized);
+    int length = reverseComplementSequence(sequence.constData(), sequence.length(),
+                                           reverseComplement.data());
+    reverseComplement.resize(length);
+    return reverseComplement;
+}
+
+
+//If the file has been changed since it was loaded, the sequence may be
+//shorter than asked for, but the read never goes past the end of the file.
+QByteArray SequenceFile::read(long long offset, int length)
+{
+    QByteArray sequence;
+    if (offset < 0 || length <= 0 || offset >= m_fileSize)
+        return sequence;
+    sequence.reserve(length);
+
+    if (m_mapping != 0)
+    {
+        const char * start = reinterpret_cast<const char *>(m_mapping) + offset;
+        const char * end = reinterpret_cast<const char *>(m_mapping) + m_fileSize;
+        appendSkippingWhitespace(start, end, length, &sequence);
+        return sequence;
+    }
+
+    //Without a mapping, the file position is shared, so only one thread can
+    //read at a time.  The file is read in pieces until the sequence is done,
+    //as whitespace and line breaks make it longer in the file than its
+    //length.
+    QMutexLocker locker(&m_mutex);
+    if (!m_file.seek(offset))
+        return sequence;
+    while (sequence.length() < length)
+    {
+        QByteArray piece = m_file.read(qMax(length - sequence.length(), 4096));
+        if (piece.isEmpty())
+            break;
+        appendSkippingWhitespace(piece.constData(), piece.constData() + piece.length(),
+                                 length, &sequence);
+    }
+    return sequence;
+}
+
+
+//This function appends bases from the given range until the sequence
+//reaches the length, leaving out the same whitespace (including line breaks
+//and the carriage returns of Windows line endings) that the parsers leave
+//out when they hold sequences themselves.
+void SequenceFile::appendSkippingWhitespace(const char * start, const char * end, int length,
+                                            QByteArray * sequence)
+{
+    const char * position = start;
+    while (position < end && sequence->length() < length)
+    {
+        while (position < end && isWhitespace(*position))
+            ++position;
+
+        const char * runStart = position;
+        const char * runLimit = position + qMin((long long)(length - sequence->length()),
+                                                (long long)(end - position));
+        while (position < runLimit && !isWhitespace(*position))
+            ++position;
+        sequence->append(runStart, int(position - runStart));
+    }
+}
@@ -0,0 +1,70 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef SEQUENCEFILE_H
+#define SEQUENCEFILE_H
+
+#include <QString>
+#include <QFile>
+#include <QByteArray>
+#include <QMutex>
+#include <vector>
+
+//This class gives node sequences from the graph file itself, so that nodes
+//don't need to store their sequences.  It only exists when sequences are
+//loaded on demand.  Where each sequence is in the file (an offset and a
+//length) is kept in this class's list, and a node only holds its index in
+//the list.  The file is memory-mapped, so reading a sequence only touches
+//the pages it is on.
+//A sequence can be split over several lines, as in FASTG files.  The offset
+//is that of its first base and the length is the number of bases, not
+//counting the whitespace and line breaks between them.
+class SequenceFile
+{
+public:
+    SequenceFile(QString fullFileName);
+    ~SequenceFile();
+
+    bool open();
+    int addSequence(long long offset, int length, bool reverseComplement);
+    int addReverseComplement(int index);
+    QByteArray getSequence(int index);
+    int getSequenceLength(int index) const {return m_sequences[index].m_length;}
+    long long getSequenceOffset(int index) const {return m_sequences[index].m_offset;}
+    bool isReverseComplement(int index) const {return m_sequences[index].m_reverseComplement;}
+
+private:
+    struct SequenceLocation
+    {
+        long long m_offset;
+        int m_length;
+        bool m_reverseComplement;
+    };
+
+    QFile m_file;
+    uchar * m_mapping;
+    long long m_fileSize;
+    QMutex m_mutex;
+    std::vector<SequenceLocation> m_sequences;
+
+    QByteArray read(long long offset, int length);
+    static void appendSkippingWhitespace(const char * start, const char * end, int length,
+                                         QByteArray * sequence);
+};
+
+#endif // SEQUENCEFILE_H
@@ -0,0 +1,189 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "trinityparser.h"
+#include "debruijnnodetable.h"
+#include "../program/globals.h"
+#include "../program/linereader.h"
+#include <string.h>
+#include <algorithm>
+
+
+//This function reads the digits at the position and moves past them.
+static long long readNumber(const char ** position, const char * end)
+{
+    const char * start = *position;
+    while (*position < end && **position >= '0' && **position <= '9')
+        ++(*position);
+    return parseLongLong(start, int(*position - start));
+}
+
+
+//This function reads the transcript and component numbers from a header in
+//one pass.  The header can come in a few different formats:
+// TR1|c0_g1_i1 len=280 path=[274:0-228 275:229-279] [-1, 274, 275, -2]
+// GG1|c0_g1_i1 len=302 path=[1:0-301]
+// comp0_c0_seq1 len=286 path=[6:0-285]
+// c0_g1_i1 len=363 path=[119:0-185 43:186-244 43:245-303 43:304-362]
+//Some of the formats don't include the transcript number, so 0 is used in
+//those cases.
+static bool parseTrinityComponent(const char * name, const char * end,
+                                  int * transcript, int * component)
+{
+    const char * position = name;
+    if (end - position < 4)
+        return false;
+
+    if ((position[0] == 'T' && position[1] == 'R') || (position[0] == 'G' && position[1] == 'G'))
+    {
+        position += 2;
+        *transcript = int(readNumber(&position, end));
+        while (position + 1 < end && !(position[0] == '|' && position[1] == 'c'))
+            ++position;
+        if (position + 1 >= end)
+            return false;
+        position += 2;
+    }
+    else if (memcmp(position, "comp", 4) == 0)
+    {
+        *transcript = 0;
+        position += 4;
+    }
+    else if (position[0] == 'c' && position[1] >= '0' && position[1] <= '9')
+    {
+        *transcript = 0;
+        position += 1;
+    }
+
+    //If the header doesn't match any of the previous options, then I don't
+    //know what's going on.
+    else
+        return false;
+
+    *component = int(readNumber(&position, end));
+    return position < end && *position == '_';
+}
+
+
+//This function parses one record: each part of the header's path is a node
+//(given as node:start-end in the transcript sequence) and consecutive parts
+//are joined by an edge.
+static bool parseTrinityRecord(const QByteArray & name, const QByteArray & sequence, TrinityChunk & chunk)
+{
+    const char * start = name.constData();
+    const char * end = start + name.length();
+
+    int transcript, component;
+    if (!parseTrinityComponent(start, end, &transcript, &component))
+        return false;
+
+    const char * pathStart = 0;
+    for (const char * position = start; position + 6 <= end; ++position)
+    {
+        if (memcmp(position, "path=[", 6) == 0)
+        {
+            pathStart = position + 6;
+            break;
+        }
+    }
+    if (pathStart == 0)
+        return false;
+    const char * pathEnd = static_cast<const char *>(memchr(pathStart, ']', end - pathStart));
+    if (pathEnd == 0 || pathEnd == pathStart)
+        return false;
+
+    long long previousNodeNumber = 0;
+    bool firstPart = true;
+    const char * position = pathStart;
+    while (position <= pathEnd)
+    {
+        const char * partEnd = static_cast<const char *>(memchr(position, ' ', pathEnd - position));
+        if (partEnd == 0)
+            partEnd = pathEnd;
+
+        const char * colon = static_cast<const char *>(memchr(position, ':', partEnd - position));
+        if (colon == 0)
+            return false;
+
+        //Most node numbers will be formatted simply as the number, but some
+        //(I don't know why) have '@' and the start and '@!' at the end.  In
+        //these cases, we must strip those extra characters off.
+        const char * numberStart = position;
+        const char * numberEnd = colon;
+        if (numberStart < numberEnd && *numberStart == '@')
+        {
+            ++numberStart;
+            numberEnd = std::max(numberStart, numberEnd - 2);
+        }
+        long long nodeNumber = parseLongLong(numberStart, int(numberEnd - numberStart));
+        nodeNumber = getFullTrinityNodeNumberFromParts(transcript, component, nodeNumber);
+
+        //The node table isn't changed while chunks are parsed, so it is
+        //safe to look in from any thread.
+        if (!chunk.m_existingNodes->contains(nodeNumber) && !chunk.m_seenNodes.contains(nodeNumber))
+        {
+            chunk.m_seenNodes.insert(nodeNumber);
+            const char * dash = static_cast<const char *>(memchr(colon + 1, '-', partEnd - colon - 1));
+            if (dash == 0)
+                return false;
+            int rangeStart = int(parseLongLong(colon + 1, int(dash - colon - 1)));
+            int rangeEnd = int(parseLongLong(dash + 1, int(partEnd - dash - 1)));
+
+            TrinityNodeRecord node;
+            node.m_number = nodeNumber;
+            node.m_length = rangeEnd - rangeStart + 1;
+            node.m_sequence = PackedSequence(sequence.mid(rangeStart, node.m_length));
+            chunk.m_nodes.push_back(node);
+        }
+
+        //Remember to make an edge for the previous node to this one.
+        if (!firstPart)
+        {
+            chunk.m_edgeStartingNodeNumbers.push_back(previousNodeNumber);
+            chunk.m_edgeEndingNodeNumbers.push_back(nodeNumber);
+        }
+        previousNodeNumber = nodeNumber;
+        firstPart = false;
+
+        position = partEnd + 1;
+    }
+
+    return true;
+}
+
+
+//This function is run on the thread pool, so it doesn't throw: problems are
+//recorded in the chunk's error flag instead.  The records are freed once
+//they are parsed.
+void parseTrinityChunk(TrinityChunk & chunk)
+{
+    for (size_t i = 0; i < chunk.m_names.size(); ++i)
+    {
+        if (chunk.m_names[i].length() == 0)
+            continue;
+        if (!parseTrinityRecord(chunk.m_names[i], chunk.m_sequences[i], chunk))
+        {
+            chunk.m_error = true;
+            break;
+        }
+    }
+
+    std::vector<QByteArray>().swap(chunk.m_names);
+    std::vector<QByteArray>().swap(chunk.m_sequences);
+    chunk.m_seenNodes.clear();
+}
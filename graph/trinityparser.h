@@ -0,0 +1,61 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef TRINITYPARSER_H
+#define TRINITYPARSER_H
+
+#include <vector>
+#include <QByteArray>
+#include "packedsequence.h"
+#include <QSet>
+
+class DeBruijnNodeTable;
+
+struct TrinityNodeRecord
+{
+    long long m_number;
+    int m_length;
+    PackedSequence m_sequence;
+};
+
+//A TrinityChunk is a run of consecutive records from a Trinity.fasta file.
+//Components are independent of each other, so chunks can be parsed in
+//parallel.  A node usually appears in many transcripts, so each chunk only
+//makes a record for a node the first time it sees it, and not at all if
+//the node was made from an earlier batch.  A node can still be in more than
+//one chunk of a batch, so the chunks are merged in file order and only the
+//first record for each node is kept, as for a serial load.  Edges are kept
+//per chunk and merged in file order.
+struct TrinityChunk
+{
+    TrinityChunk() : m_existingNodes(0), m_error(false) {}
+
+    std::vector<QByteArray> m_names;
+    std::vector<QByteArray> m_sequences;
+    const DeBruijnNodeTable * m_existingNodes;
+    QSet<long long> m_seenNodes;
+
+    std::vector<TrinityNodeRecord> m_nodes;
+    std::vector<long long> m_edgeStartingNodeNumbers;
+    std::vector<long long> m_edgeEndingNodeNumbers;
+    bool m_error;
+};
+
+void parseTrinityChunk(TrinityChunk & chunk);
+
+#endif // TRINITYPARSER_H
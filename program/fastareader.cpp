@@ -0,0 +1,71 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "fastareader.h"
+
+FastaReader::FastaReader(QString fullFileName) :
+    m_lineReader(fullFileName), m_nextHeader(0), m_nextHeaderLength(0),
+    m_previousSequenceLength(0)
+{
+}
+
+
+//This function gives the next record in the file, without the '>' at the
+//start of its name.  Any lines before the first header are ignored.  It
+//returns false when there are no more records.
+bool FastaReader::readRecord(QByteArray * name, QByteArray * sequence)
+{
+    const char * line;
+    int lineLength;
+
+    //Find the header for this record, which may have already been read as
+    //the line that ended the previous record.
+    while (m_nextHeader == 0)
+    {
+        if (!m_lineReader.readLine(&line, &lineLength))
+            return false;
+        if (lineLength > 0 && line[0] == '>')
+        {
+            m_nextHeader = line;
+            m_nextHeaderLength = lineLength;
+        }
+    }
+
+    *name = QByteArray(m_nextHeader + 1, m_nextHeaderLength - 1);
+    m_nextHeader = 0;
+
+    //Reserving the previous record's length means files of similarly sized
+    //sequences rarely need to reallocate as sequences grow.
+    sequence->clear();
+    sequence->reserve(m_previousSequenceLength);
+
+    while (m_lineReader.readLine(&line, &lineLength))
+    {
+        if (lineLength > 0 && line[0] == '>')
+        {
+            m_nextHeader = line;
+            m_nextHeaderLength = lineLength;
+            break;
+        }
+
+        appendWithoutWhitespace(line, lineLength, sequence);
+    }
+
+    m_previousSequenceLength = sequence->length();
+    return true;
+}
@@ -0,0 +1,48 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef FASTAREADER_H
+#define FASTAREADER_H
+
+#include <QString>
+#include <QByteArray>
+#include "linereader.h"
+
+//This class reads a FASTA file one record at a time.  Names and sequences
+//are given as Latin-1 byte arrays, with whitespace trimmed from each
+//sequence line, so records never need to be held as UTF-16 strings.
+class FastaReader
+{
+public:
+    FastaReader(QString fullFileName);
+
+    bool open() {return m_lineReader.open();}
+    void close() {m_lineReader.close();}
+    bool readRecord(QByteArray * name, QByteArray * sequence);
+    bool hasError() const {return m_lineReader.hasError();}
+    long long totalBytes() const {return m_lineReader.totalBytes();}
+    long long bytesRead() const {return m_lineReader.bytesRead();}
+
+private:
+    LineReader m_lineReader;
+    const char * m_nextHeader;
+    int m_nextHeaderLength;
+    int m_previousSequenceLength;
+};
+
+#endif // FASTAREADER_H
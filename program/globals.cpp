@@ -20,9 +20,7 @@
 #include <QLocale>
 #include <QDir>
 #include <QStringList>
-#include <QFile>
-#include <QTextStream>
-#include <QApplication>
+#include "fastareader.h"
 
 Settings * g_settings;
 MyGraphicsView * g_graphicsView;
@@ -80,50 +78,21 @@ void emptyTempDirectory()
 }
 
 
-void readFastaFile(QString filename, std::vector<QString> * names, std::vector<QString> * sequences)
+void readFastaFile(QString filename, std::vector<QString> * names, std::vector<QByteArray> * sequences)
 {
-    QFile inputFile(filename);
-    if (inputFile.open(QIODevice::ReadOnly))
+    FastaReader in(filename);
+    if (in.open())
     {
-        QString name = "";
-        QString sequence = "";
-
-        QTextStream in(&inputFile);
-        while (!in.atEnd())
+        QByteArray name;
+        QByteArray sequence;
+        while (in.readRecord(&name, &sequence))
         {
-            QApplication::processEvents();
-
-            QString line = in.readLine();
-
-            if (line.length() == 0)
+            if (name.length() == 0)
                 continue;
-
-            if (line.at(0) == '>')
-            {
-                //If there is a current sequence, add it to the vectors now.
-                if (name.length() > 0)
-                {
-                    names->push_back(name);
-                    sequences->push_back(sequence);
-                }
-
-                line.remove(0, 1); //Remove '>' from start
-                name = line;
-                sequence = "";
-            }
-
-            else //It's a sequence line
-                sequence += line.simplified();
-        }
-
-        //Add the last target to the results now.
-        if (name.length() > 0)
-        {
-            names->push_back(name);
+            names->push_back(QString::fromLatin1(name));
             sequences->push_back(sequence);
         }
-
-        inputFile.close();
+        in.close();
     }
 }
 
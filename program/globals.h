@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <QString>
+#include <QByteArray>
 
 class Settings;
 class MyGraphicsView;
@@ -28,12 +29,14 @@ class BlastSearch;
 class AssemblyGraph;
 
 enum NodeColourScheme {ONE_COLOUR, RANDOM_COLOURS, COVERAGE_COLOUR, BLAST_HITS_COLOUR, CONTIGUITY_COLOUR, CUSTOM_COLOURS};
-enum GraphScope {WHOLE_GRAPH, AROUND_NODE, AROUND_BLAST_HITS};
+enum GraphScope {WHOLE_GRAPH, AROUND_NODE, AROUND_NODE_BASE_PAIRS, AROUND_BLAST_HITS};
 enum ContiguityStatus {STARTING, CONTIGUOUS_STRAND_SPECIFIC, CONTIGUOUS_EITHER_STRAND, MAYBE_CONTIGUOUS, NOT_CONTIGUOUS};
 enum NodeDragging {ONE_PIECE, NEARBY_PIECES, ALL_PIECES};
 enum ZoomSource {MOUSE_WHEEL, SPIN_BOX, KEYBOARD};
 enum UiState {NO_GRAPH_LOADED, GRAPH_LOADED, GRAPH_DRAWN};
 enum NodeLengthMode {AUTO_NODE_LENGTH, MANUAL_NODE_LENGTH};
+enum ReadTrackingMode {SKIP_READ_TRACKING, LOAD_READ_TRACKING};
+enum SequenceLoadingMode {LOAD_SEQUENCES, LOAD_SEQUENCES_ON_DEMAND};
 
 extern Settings * g_settings;
 extern MyGraphicsView * g_graphicsView;
@@ -55,6 +58,6 @@ QString getTrinityNodeNameFromFullNodeNumber(long long fullNodeNumber);
 
 void emptyTempDirectory();
 
-void readFastaFile(QString filename, std::vector<QString> * names, std::vector<QString> * sequences);
+void readFastaFile(QString filename, std::vector<QString> * names, std::vector<QByteArray> * sequences);
 
 #endif // GLOBALS_H
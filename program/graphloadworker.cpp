@@ -0,0 +1,153 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "graphloadworker.h"
+#include "../graph/assemblygraph.h"
+#include "../graph/graphcache.h"
+#include "globals.h"
+#include "settings.h"
+#include <QThread>
+
+GraphLoadWorker::GraphLoadWorker(QString graphFileType, QString fullFileName) :
+    m_graphFileType(graphFileType), m_fullFileName(fullFileName),
+    m_assemblyGraph(0), m_succeeded(false), m_cancelled(0), m_lastProgress(-1)
+{
+}
+
+
+//The graph is built into a new AssemblyGraph object which the main window
+//takes as a whole when loading finishes.  If loading fails or is cancelled,
+//the partially built graph is deleted here.
+//If there is an up-to-date cache for the graph file, the graph is loaded from
+//that instead.  Otherwise, a cache is made after the graph file is loaded.
+//Read positions aren't cached, so caches aren't used when they are loaded.
+void GraphLoadWorker::loadGraph()
+{
+    m_assemblyGraph = new AssemblyGraph();
+
+    try
+    {
+        bool useCache = g_settings->readTrackingMode == SKIP_READ_TRACKING;
+        bool loadedFromCache = false;
+        if (useCache)
+        {
+            m_assemblyGraph->m_graphCache = new GraphCache(m_graphFileType, m_fullFileName);
+            loadedFromCache = m_assemblyGraph->m_graphCache->load(m_assemblyGraph, this);
+            if (!loadedFromCache)
+                m_assemblyGraph->cleanUp();
+        }
+
+        if (!loadedFromCache)
+        {
+            if (m_graphFileType == "LastGraph")
+                m_assemblyGraph->buildDeBruijnGraphFromLastGraph(m_fullFileName, this);
+            else if (m_graphFileType == "FASTG")
+                m_assemblyGraph->buildDeBruijnGraphFromFastg(m_fullFileName, this);
+            else if (m_graphFileType == "Trinity.fasta")
+                m_assemblyGraph->buildDeBruijnGraphFromTrinityFasta(m_fullFileName, this);
+            else if (m_graphFileType == "GFA")
+                m_assemblyGraph->buildDeBruijnGraphFromGfa(m_fullFileName, this);
+        }
+
+        m_assemblyGraph->buildNodeColumns();
+        m_assemblyGraph->buildEdgeAdjacency();
+
+        if (!loadedFromCache)
+        {
+            m_assemblyGraph->determineGraphInfo();
+            if (useCache && !isCancelled())
+                GraphCache(m_graphFileType, m_fullFileName).save(m_assemblyGraph);
+        }
+
+        m_succeeded = !isCancelled();
+    }
+
+    catch (...)
+    {
+        m_succeeded = false;
+    }
+
+    if (!m_succeeded)
+    {
+        delete m_assemblyGraph;
+        m_assemblyGraph = 0;
+    }
+
+    emit finishedLoading();
+}
+
+
+//This slot is connected directly (not queued), as the worker's thread is
+//busy loading and would not otherwise see the request until it finished.
+void GraphLoadWorker::cancel()
+{
+    m_cancelled.fetchAndStoreOrdered(1);
+}
+
+
+bool GraphLoadWorker::isCancelled() const
+{
+    return m_cancelled.loadAcquire() != 0;
+}
+
+
+//This function is called by the loaders with how far through the file they
+//are.  A signal is only emitted when the progress (in tenths of a percent)
+//changes, so it is cheap to call often.  It returns false if loading has
+//been cancelled.
+bool GraphLoadWorker::reportProgress(long long done, long long total)
+{
+    if (total > 0)
+    {
+        int progress = int(1000 * done / total);
+        if (progress != m_lastProgress)
+        {
+            m_lastProgress = progress;
+            emit progressChanged(progress);
+        }
+    }
+
+    return !isCancelled();
+}
+
+
+//This function waits for work running on the thread pool, passing on its
+//progress: the work takes the loading from doneBefore to doneAfter out of
+//total.  If loading is cancelled in the meantime, the remaining work is
+//cancelled too and the function returns false.
+bool GraphLoadWorker::waitForFuture(QFuture<void> future, long long doneBefore, long long doneAfter, long long total)
+{
+    while (!future.isFinished())
+    {
+        long long futureRange = future.progressMaximum() - future.progressMinimum();
+        long long futureDone = future.progressValue() - future.progressMinimum();
+        long long done = doneBefore;
+        if (futureRange > 0)
+            done += (doneAfter - doneBefore) * futureDone / futureRange;
+
+        if (!reportProgress(done, total))
+        {
+            future.cancel();
+            future.waitForFinished();
+            return false;
+        }
+        QThread::msleep(50);
+    }
+
+    return reportProgress(doneAfter, total);
+}
@@ -0,0 +1,61 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef GRAPHLOADWORKER_H
+#define GRAPHLOADWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QAtomicInt>
+#include <QFuture>
+
+class AssemblyGraph;
+
+//This class builds a new AssemblyGraph from a file in a different thread, so
+//the UI stays responsive while large graphs load.  The loaders report their
+//progress through reportProgress and stop when it returns false.
+class GraphLoadWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    GraphLoadWorker(QString graphFileType, QString fullFileName);
+
+    QString m_graphFileType;
+    QString m_fullFileName;
+    AssemblyGraph * m_assemblyGraph;
+    bool m_succeeded;
+
+    bool isCancelled() const;
+    bool reportProgress(long long done, long long total);
+    bool waitForFuture(QFuture<void> future, long long doneBefore, long long doneAfter, long long total);
+
+private:
+    QAtomicInt m_cancelled;
+    int m_lastProgress;
+
+public slots:
+    void loadGraph();
+    void cancel();
+
+signals:
+    void progressChanged(int progress);
+    void finishedLoading();
+};
+
+#endif // GRAPHLOADWORKER_H
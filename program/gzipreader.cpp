@@ -0,0 +1,370 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "gzipreader.h"
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
+//These are the amounts of data decompressed in each batch.  BGZF blocks hold
+//up to 64 kB, so a BGZF batch is up to 16 MB.
+static const int BGZF_BLOCKS_PER_BATCH = 256;
+static const int GZIP_INPUT_SIZE = 1024 * 1024;
+static const int GZIP_BATCH_SIZE = 16 * 1024 * 1024;
+
+
+static unsigned int readLittleEndian(const char * bytes, int byteCount)
+{
+    unsigned int value = 0;
+    for (int i = byteCount - 1; i >= 0; --i)
+        value = (value << 8) | static_cast<unsigned char>(bytes[i]);
+    return value;
+}
+
+
+//This function looks through a gzip header's extra field for the BGZF
+//subfield, which gives the size of the whole block.  It returns 0 if the
+//header isn't a BGZF header.
+static int getBgzfBlockSize(const char * header, int extraLength)
+{
+    const char * extra = header + 12;
+    int position = 0;
+    while (position + 4 <= extraLength)
+    {
+        int subfieldLength = int(readLittleEndian(extra + position + 2, 2));
+        if (extra[position] == 'B' && extra[position + 1] == 'C' && subfieldLength == 2 &&
+                position + 6 <= extraLength)
+            return int(readLittleEndian(extra + position + 4, 2)) + 1;
+        position += 4 + subfieldLength;
+    }
+    return 0;
+}
+
+
+//This function is run on the thread pool for each block of a BGZF batch.
+static void inflateBgzfBlock(BgzfBlock & block)
+{
+    block.m_ok = false;
+
+    const char * data = block.m_compressed.constData();
+    int blockSize = block.m_compressed.size();
+    int headerSize = 12 + int(readLittleEndian(data + 10, 2));
+    int compressedSize = blockSize - headerSize - 8;
+    if (compressedSize < 0)
+        return;
+
+    unsigned int expectedCrc = readLittleEndian(data + blockSize - 8, 4);
+    unsigned int uncompressedSize = readLittleEndian(data + blockSize - 4, 4);
+    block.m_uncompressed.resize(int(uncompressedSize));
+
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data + headerSize));
+    stream.avail_in = uInt(compressedSize);
+    stream.next_out = reinterpret_cast<Bytef *>(block.m_uncompressed.data());
+    stream.avail_out = uInt(uncompressedSize);
+    if (inflateInit2(&stream, -15) != Z_OK)
+        return;
+    int result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+
+    if (result != Z_STREAM_END || stream.total_out != uncompressedSize)
+        return;
+
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(block.m_uncompressed.constData()), uInt(uncompressedSize));
+    block.m_ok = (crc == expectedCrc);
+    block.m_compressed.clear();
+}
+
+
+
+
+GzipReader::GzipReader(QFile * file) :
+    m_file(file), m_bgzf(false), m_started(false), m_batchRunning(false),
+    m_inputFinished(false), m_error(false), m_compressedBytesRead(0),
+    m_streamInitialised(false), m_atMemberEnd(false), m_batchError(false),
+    m_batchCompressedBytes(0)
+{
+}
+
+GzipReader::~GzipReader()
+{
+    if (m_batchRunning)
+        m_batchFuture.waitForFinished();
+    if (m_streamInitialised)
+        inflateEnd(&m_stream);
+}
+
+
+bool GzipReader::isGzipFile(QFile * file)
+{
+    QByteArray magic = file->peek(2);
+    return magic.size() == 2 && magic.at(0) == '\x1f' && magic.at(1) == '\x8b';
+}
+
+
+//This function decompresses only the start of a gzip file, up to maxLength
+//bytes, without setting up the batches used to read the whole file.  It is
+//for a quick look at the first line.  The file should be positioned at its
+//start.
+bool GzipReader::readStart(QFile * file, int maxLength, QByteArray * start)
+{
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = Z_NULL;
+    stream.avail_in = 0;
+    if (inflateInit2(&stream, 15 + 16) != Z_OK)
+        return false;
+
+    start->resize(maxLength);
+    stream.next_out = reinterpret_cast<Bytef *>(start->data());
+    stream.avail_out = uInt(maxLength);
+
+    //The compressed data is read in small pieces, as the output usually
+    //fills up from the first one.
+    int result = Z_OK;
+    while (result == Z_OK && stream.avail_out > 0)
+    {
+        QByteArray input = file->read(4096);
+        if (input.isEmpty())
+            break;
+        stream.next_in = reinterpret_cast<Bytef *>(input.data());
+        stream.avail_in = uInt(input.size());
+        result = inflate(&stream, Z_NO_FLUSH);
+    }
+
+    start->resize(maxLength - int(stream.avail_out));
+    inflateEnd(&stream);
+    return result == Z_OK || result == Z_STREAM_END;
+}
+
+
+//This function checks whether the file is BGZF, and if not, sets up zlib to
+//decompress it as an ordinary gzip stream.  The file should be positioned at
+//its start.
+bool GzipReader::open()
+{
+    QByteArray header = m_file->peek(18);
+    if (header.size() >= 12 && (header.at(3) & 4) != 0)
+    {
+        int extraLength = int(readLittleEndian(header.constData() + 10, 2));
+        if (header.size() >= 12 + extraLength)
+            m_bgzf = getBgzfBlockSize(header.constData(), extraLength) > 0;
+    }
+
+    if (!m_bgzf)
+    {
+        m_stream.zalloc = Z_NULL;
+        m_stream.zfree = Z_NULL;
+        m_stream.opaque = Z_NULL;
+        m_stream.next_in = Z_NULL;
+        m_stream.avail_in = 0;
+
+        //Adding 16 to the window bits makes zlib expect a gzip header.
+        if (inflateInit2(&m_stream, 15 + 16) != Z_OK)
+            return false;
+        m_streamInitialised = true;
+    }
+
+    return true;
+}
+
+
+//This function appends the next batch of decompressed data to the buffer
+//and starts decompressing the batch after it.  It returns false when there
+//is nothing left to decompress or there was an error.
+bool GzipReader::readMore(QByteArray * buffer)
+{
+    if (!m_started)
+    {
+        m_started = true;
+        startNextBatch();
+    }
+
+    while (m_batchRunning)
+    {
+        m_batchFuture.waitForFinished();
+        m_batchRunning = false;
+
+        int sizeBefore = buffer->size();
+        if (m_bgzf)
+        {
+            for (size_t i = 0; i < m_bgzfBlocks.size(); ++i)
+            {
+                if (!m_bgzfBlocks[i].m_ok)
+                {
+                    m_error = true;
+                    break;
+                }
+                buffer->append(m_bgzfBlocks[i].m_uncompressed);
+            }
+            m_bgzfBlocks.clear();
+        }
+        else
+        {
+            m_error = m_error || m_batchError;
+            m_compressedBytesRead = m_batchCompressedBytes;
+            buffer->append(m_batchOutput);
+            m_batchOutput.clear();
+        }
+
+        if (m_error)
+            return false;
+        startNextBatch();
+        if (buffer->size() > sizeBefore)
+            return true;
+    }
+
+    return false;
+}
+
+
+void GzipReader::startNextBatch()
+{
+    if (m_inputFinished || m_error)
+        return;
+
+    if (m_bgzf)
+    {
+        if (!readBgzfBatch() || m_bgzfBlocks.empty())
+            return;
+        m_batchFuture = QtConcurrent::map(m_bgzfBlocks, inflateBgzfBlock);
+    }
+    else
+        m_batchFuture = QtConcurrent::run(this, &GzipReader::inflateGzipBatch);
+
+    m_batchRunning = true;
+}
+
+
+//This function reads the compressed blocks for the next BGZF batch.  The
+//file is read here, in order, and only the decompression is parallel.
+bool GzipReader::readBgzfBatch()
+{
+    m_bgzfBlocks.clear();
+    m_bgzfBlocks.reserve(BGZF_BLOCKS_PER_BATCH);
+
+    while (int(m_bgzfBlocks.size()) < BGZF_BLOCKS_PER_BATCH)
+    {
+        QByteArray header = m_file->read(18);
+        if (header.size() == 0)
+        {
+            m_inputFinished = true;
+            break;
+        }
+
+        int blockSize = 0;
+        if (header.size() == 18 && header.at(0) == '\x1f' && header.at(1) == '\x8b' &&
+                (header.at(3) & 4) != 0)
+        {
+            int extraLength = int(readLittleEndian(header.constData() + 10, 2));
+            if (extraLength <= 6)
+                blockSize = getBgzfBlockSize(header.constData(), extraLength);
+            else
+            {
+                header.append(m_file->read(12 + extraLength - 18));
+                if (header.size() == 12 + extraLength)
+                    blockSize = getBgzfBlockSize(header.constData(), extraLength);
+            }
+        }
+
+        if (blockSize < header.size() + 8)
+        {
+            m_error = true;
+            return false;
+        }
+
+        BgzfBlock block;
+        block.m_compressed = header;
+        block.m_compressed.append(m_file->read(blockSize - header.size()));
+        block.m_ok = false;
+        if (block.m_compressed.size() != blockSize)
+        {
+            m_error = true;
+            return false;
+        }
+
+        m_compressedBytesRead += blockSize;
+        m_bgzfBlocks.push_back(block);
+    }
+
+    return true;
+}
+
+
+//This function is run on the thread pool to decompress the next batch of an
+//ordinary gzip file.  Only one batch runs at a time, so it has the zlib
+//stream and the file to itself.  Files made of several gzip members (e.g.
+//by concatenating gzip files) are read as one stream.
+void GzipReader::inflateGzipBatch()
+{
+    m_batchOutput.resize(GZIP_BATCH_SIZE);
+    m_stream.next_out = reinterpret_cast<Bytef *>(m_batchOutput.data());
+    m_stream.avail_out = uInt(GZIP_BATCH_SIZE);
+
+    while (m_stream.avail_out > 0)
+    {
+        if (m_stream.avail_in == 0)
+        {
+            m_input = m_file->read(GZIP_INPUT_SIZE);
+            m_batchCompressedBytes += m_input.size();
+            if (m_input.size() == 0)
+            {
+                //The file ending part way through a member means it was
+                //truncated.
+                m_inputFinished = true;
+                m_batchError = !m_atMemberEnd;
+                break;
+            }
+            m_stream.next_in = reinterpret_cast<Bytef *>(m_input.data());
+            m_stream.avail_in = uInt(m_input.size());
+        }
+
+        int result = inflate(&m_stream, Z_NO_FLUSH);
+        if (result == Z_STREAM_END)
+        {
+            m_atMemberEnd = true;
+            inflateReset(&m_stream);
+        }
+        else if (result == Z_OK || result == Z_BUF_ERROR)
+        {
+            if (m_stream.total_in > 0)
+                m_atMemberEnd = false;
+        }
+
+        //Data that isn't gzip after the end of a member (e.g. padding) is
+        //ignored, as gunzip does.
+        else if (m_atMemberEnd)
+        {
+            m_inputFinished = true;
+            break;
+        }
+        else
+        {
+            m_batchError = true;
+            m_inputFinished = true;
+            break;
+        }
+    }
+
+    m_batchOutput.resize(GZIP_BATCH_SIZE - int(m_stream.avail_out));
+}
@@ -0,0 +1,80 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef GZIPREADER_H
+#define GZIPREADER_H
+
+#include <vector>
+#include <QFile>
+#include <QByteArray>
+#include <QFuture>
+#include <zlib.h>
+
+struct BgzfBlock
+{
+    QByteArray m_compressed;
+    QByteArray m_uncompressed;
+    bool m_ok;
+};
+
+//This class decompresses a gzip file in batches for LineReader.  While the
+//caller works on one batch, the next is decompressed on the thread pool.
+//BGZF files (as made by bgzip) are made of independently compressed blocks,
+//so the blocks in each batch are also decompressed in parallel.  Other gzip
+//files have to be decompressed in order, one batch at a time.
+class GzipReader
+{
+public:
+    GzipReader(QFile * file);
+    ~GzipReader();
+
+    static bool isGzipFile(QFile * file);
+    static bool readStart(QFile * file, int maxLength, QByteArray * start);
+
+    bool open();
+    bool readMore(QByteArray * buffer);
+    bool isFinished() const {return m_started && !m_batchRunning;}
+    bool hasError() const {return m_error;}
+    long long compressedBytesRead() const {return m_compressedBytesRead;}
+
+private:
+    QFile * m_file;
+    bool m_bgzf;
+    bool m_started;
+    bool m_batchRunning;
+    bool m_inputFinished;
+    bool m_error;
+    long long m_compressedBytesRead;
+    QFuture<void> m_batchFuture;
+
+    std::vector<BgzfBlock> m_bgzfBlocks;
+
+    z_stream m_stream;
+    bool m_streamInitialised;
+    bool m_atMemberEnd;
+    QByteArray m_input;
+    QByteArray m_batchOutput;
+    bool m_batchError;
+    long long m_batchCompressedBytes;
+
+    void startNextBatch();
+    bool readBgzfBatch();
+    void inflateGzipBatch();
+};
+
+#endif // GZIPREADER_H
@@ -0,0 +1,482 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "linereader.h"
+#include "gzipreader.h"
+#include <algorithm>
+#include <string.h>
+#include <math.h>
+
+//Files that can't be mapped are read in batches of this size.
+static const int STREAMING_BATCH_SIZE = 16 * 1024 * 1024;
+
+LineReader::LineReader(QString fullFileName) :
+    m_file(fullFileName), m_mapping(0), m_gzipReader(0), m_streaming(false), m_readError(false),
+    m_bufferFileOffset(0), m_start(0), m_position(0), m_end(0)
+{
+}
+
+LineReader::~LineReader()
+{
+    close();
+}
+
+
+bool LineReader::open()
+{
+    close();
+
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    //Gzipped files are decompressed into the buffer as they are read.
+    if (GzipReader::isGzipFile(&m_file))
+    {
+        m_gzipReader = new GzipReader(&m_file);
+        if (!m_gzipReader->open())
+        {
+            close();
+            return false;
+        }
+        readMore();
+        return true;
+    }
+
+    qint64 fileSize = m_file.size();
+    if (fileSize > 0)
+        m_mapping = m_file.map(0, fileSize);
+
+    //Some files (e.g. pipes or some network file systems) can't be mapped,
+    //and a 32-bit build can't map a very large file.  These are read into the
+    //buffer a batch at a time, so the whole file is never in memory at once.
+    if (m_mapping == 0)
+    {
+        m_streaming = true;
+        readMore();
+        return true;
+    }
+
+    m_start = reinterpret_cast<const char *>(m_mapping);
+    m_position = m_start;
+    m_end = m_start + fileSize;
+    return true;
+}
+
+
+void LineReader::close()
+{
+    delete m_gzipReader;
+    m_gzipReader = 0;
+    if (m_mapping != 0)
+        m_file.unmap(m_mapping);
+    m_mapping = 0;
+    m_fallbackBuffer.clear();
+    if (m_file.isOpen())
+        m_file.close();
+
+    m_streaming = false;
+    m_readError = false;
+    m_bufferFileOffset = 0;
+    m_start = 0;
+    m_position = 0;
+    m_end = 0;
+}
+
+
+bool LineReader::atEnd() const
+{
+    if (m_position < m_end)
+        return false;
+    if (m_gzipReader != 0)
+        return m_gzipReader->isFinished();
+    return !m_streaming || m_file.atEnd() || m_readError;
+}
+
+
+bool LineReader::hasError() const
+{
+    return m_readError || (m_gzipReader != 0 && m_gzipReader->hasError());
+}
+
+
+//For a gzipped file, these give the compressed size and position, as that
+//is what the file's size on disk relates to.
+long long LineReader::totalBytes() const
+{
+    if (isBuffered())
+        return m_file.size();
+    return m_end - m_start;
+}
+
+long long LineReader::bytesRead() const
+{
+    if (m_gzipReader != 0)
+        return m_gzipReader->compressedBytesRead();
+    return fileOffset(m_position);
+}
+
+
+//Lines from a file that isn't gzipped point into the file's contents (or a
+//batch of them), so their position in the file can be found.  This is used
+//to load sequences on demand.
+bool LineReader::givesFileOffsets() const
+{
+    return m_gzipReader == 0;
+}
+
+long long LineReader::fileOffset(const char * position) const
+{
+    return m_bufferFileOffset + (position - m_start);
+}
+
+
+//This function discards the lines that have already been read from the
+//buffer and reads (or decompresses) more of the file onto its end.  It
+//returns false if the file is mapped or there is no more to read.
+bool LineReader::readMore()
+{
+    if (!isBuffered())
+        return false;
+
+    int consumed = int(m_position - m_start);
+    m_fallbackBuffer.remove(0, consumed);
+    m_bufferFileOffset += consumed;
+
+    bool gotMore;
+    if (m_gzipReader != 0)
+        gotMore = m_gzipReader->readMore(&m_fallbackBuffer);
+    else
+    {
+        int oldSize = m_fallbackBuffer.size();
+        m_fallbackBuffer.resize(oldSize + STREAMING_BATCH_SIZE);
+        qint64 bytes = m_file.read(m_fallbackBuffer.data() + oldSize, STREAMING_BATCH_SIZE);
+        if (bytes < 0)
+        {
+            m_readError = true;
+            bytes = 0;
+        }
+        m_fallbackBuffer.resize(oldSize + int(bytes));
+        gotMore = bytes > 0;
+    }
+
+    m_start = m_fallbackBuffer.constData();
+    m_position = m_start;
+    m_end = m_start + m_fallbackBuffer.size();
+    return gotMore;
+}
+
+
+//This function gives the next line in the file, without its line ending.
+//It returns false when there are no more lines.
+bool LineReader::readLine(const char ** lineStart, int * lineLength)
+{
+    const char * newline = 0;
+    long long searched = 0;
+    while (true)
+    {
+        if (m_end - m_position > searched)
+            newline = static_cast<const char *>(memchr(m_position + searched, '\n', m_end - m_position - searched));
+        if (newline != 0)
+            break;
+        searched = m_end - m_position;
+        if (!readMore())
+            break;
+    }
+
+    if (m_position >= m_end)
+        return false;
+
+    const char * lineEnd = (newline != 0) ? newline : m_end;
+
+    *lineStart = m_position;
+    *lineLength = int(lineEnd - m_position);
+
+    //Remove the carriage return from Windows line endings.
+    if (*lineLength > 0 && (*lineStart)[*lineLength - 1] == '\r')
+        --(*lineLength);
+
+    m_position = (newline != 0) ? newline + 1 : m_end;
+    return true;
+}
+
+
+//This function gives a block of whole lines which is at least minimumLength
+//bytes long (unless the file ends first) and which ends just before a line
+//beginning with recordStart, so no record is split between two blocks.  A
+//recordStart of 0 lets the block end before any line, for files where every
+//line is a record.  For a mapped file, the whole rest of the file is given
+//as one block.
+bool LineReader::readBlock(int minimumLength, char recordStart, const char ** blockStart, const char ** blockEnd)
+{
+    if (isBuffered())
+    {
+        while (m_end - m_position < minimumLength)
+        {
+            if (!readMore())
+                break;
+        }
+
+        //Look for a line beginning with recordStart after the minimum length.
+        long long searchFrom = std::min((long long)(m_end - m_position), (long long)(std::max(minimumLength, 1))) - 1;
+        while (true)
+        {
+            const char * cut = 0;
+            const char * position = m_position + std::max(searchFrom, 0LL);
+            while (position < m_end)
+            {
+                const char * newline = static_cast<const char *>(memchr(position, '\n', m_end - position));
+                if (newline == 0 || newline + 1 >= m_end)
+                    break;
+                if (recordStart == 0 || newline[1] == recordStart)
+                {
+                    cut = newline + 1;
+                    break;
+                }
+                position = newline + 1;
+            }
+
+            if (cut != 0)
+            {
+                *blockStart = m_position;
+                *blockEnd = cut;
+                m_position = cut;
+                return true;
+            }
+
+            //The line beginning with recordStart may not have been read
+            //yet.
+            searchFrom = m_end - m_position - 1;
+            if (!readMore())
+                break;
+        }
+    }
+
+    if (m_position >= m_end)
+        return false;
+
+    *blockStart = m_position;
+    *blockEnd = m_end;
+    m_position = m_end;
+    return true;
+}
+
+
+//This function is used when the rest of the file isn't needed.  For a
+//gzipped file, it stops decompression.
+void LineReader::skipToEnd()
+{
+    delete m_gzipReader;
+    m_gzipReader = 0;
+    m_streaming = false;
+    m_position = m_end;
+}
+
+
+
+
+bool lineStartsWith(const char * lineStart, int lineLength, const char * prefix)
+{
+    int prefixLength = int(strlen(prefix));
+    return lineLength >= prefixLength && memcmp(lineStart, prefix, prefixLength) == 0;
+}
+
+
+//This function splits a line on runs of whitespace, in the same manner as
+//QString::split(QRegExp("\\s+")).  It gives at most maxTokens tokens and
+//returns the number found.
+int splitOnWhitespace(const char * lineStart, int lineLength,
+                      const char ** tokenStarts, int * tokenLengths, int maxTokens)
+{
+    const char * position = lineStart;
+    const char * lineEnd = lineStart + lineLength;
+    int tokenCount = 0;
+
+    while (position < lineEnd && tokenCount < maxTokens)
+    {
+        while (position < lineEnd && (*position == ' ' || *position == '\t'))
+            ++position;
+        if (position == lineEnd)
+            break;
+
+        const char * tokenStart = position;
+        while (position < lineEnd && *position != ' ' && *position != '\t')
+            ++position;
+
+        tokenStarts[tokenCount] = tokenStart;
+        tokenLengths[tokenCount] = int(position - tokenStart);
+        ++tokenCount;
+    }
+
+    return tokenCount;
+}
+
+
+void appendWithoutWhitespace(const char * start, int length, QByteArray * destination)
+{
+    const char * position = start;
+    const char * end = start + length;
+    while (position < end)
+    {
+        while (position < end && isWhitespace(*position))
+            ++position;
+        const char * runStart = position;
+        while (position < end && !isWhitespace(*position))
+            ++position;
+        if (position > runStart)
+            destination->append(runStart, int(position - runStart));
+    }
+}
+
+int countNonWhitespace(const char * start, int length)
+{
+    int count = 0;
+    for (int i = 0; i < length; ++i)
+    {
+        if (!isWhitespace(start[i]))
+            ++count;
+    }
+    return count;
+}
+
+
+long long parseLongLong(const char * start, int length, bool * ok)
+{
+    const char * position = start;
+    const char * end = start + length;
+
+    bool negative = false;
+    if (position < end && (*position == '-' || *position == '+'))
+    {
+        negative = (*position == '-');
+        ++position;
+    }
+
+    bool anyDigits = false;
+    long long value = 0;
+    while (position < end && *position >= '0' && *position <= '9')
+    {
+        value = value * 10 + (*position - '0');
+        anyDigits = true;
+        ++position;
+    }
+
+    if (ok != 0)
+        *ok = anyDigits && position == end;
+    if (!anyDigits || position != end)
+        return 0;
+
+    return negative ? -value : value;
+}
+
+
+//This function parses a decimal number, optionally with an exponent, using
+//the C locale.  Whenever the digits and the power of ten are both exactly
+//representable, the result is correctly rounded.
+double parseDouble(const char * start, int length, bool * ok)
+{
+    static const double powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                         1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+                                         1e20, 1e21, 1e22};
+
+    const char * position = start;
+    const char * end = start + length;
+
+    bool negative = false;
+    if (position < end && (*position == '-' || *position == '+'))
+    {
+        negative = (*position == '-');
+        ++position;
+    }
+
+    unsigned long long mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+
+    while (position < end && *position >= '0' && *position <= '9')
+    {
+        if (significantDigits < 19)
+        {
+            mantissa = mantissa * 10 + (*position - '0');
+            if (mantissa > 0)
+                ++significantDigits;
+        }
+        else
+            ++exponent;
+        anyDigits = true;
+        ++position;
+    }
+
+    if (position < end && *position == '.')
+    {
+        ++position;
+        while (position < end && *position >= '0' && *position <= '9')
+        {
+            if (significantDigits < 19)
+            {
+                mantissa = mantissa * 10 + (*position - '0');
+                if (mantissa > 0)
+                    ++significantDigits;
+                --exponent;
+            }
+            anyDigits = true;
+            ++position;
+        }
+    }
+
+    if (anyDigits && position < end && (*position == 'e' || *position == 'E'))
+    {
+        ++position;
+        bool negativeExponent = false;
+        if (position < end && (*position == '-' || *position == '+'))
+        {
+            negativeExponent = (*position == '-');
+            ++position;
+        }
+        bool anyExponentDigits = false;
+        int explicitExponent = 0;
+        while (position < end && *position >= '0' && *position <= '9')
+        {
+            if (explicitExponent < 10000)
+                explicitExponent = explicitExponent * 10 + (*position - '0');
+            anyExponentDigits = true;
+            ++position;
+        }
+        if (!anyExponentDigits)
+            anyDigits = false;
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if (ok != 0)
+        *ok = anyDigits && position == end;
+    if (!anyDigits || position != end)
+        return 0.0;
+
+    double value = double(mantissa);
+    if (mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22)
+    {
+        if (exponent < 0)
+            value /= powersOfTen[-exponent];
+        else
+            value *= powersOfTen[exponent];
+    }
+    else if (exponent != 0)
+        value *= pow(10.0, exponent);
+
+    return negative ? -value : value;
+}
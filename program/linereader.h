@@ -0,0 +1,90 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+#include <QString>
+#include <QFile>
+#include <QByteArray>
+
+class GzipReader;
+
+//This class reads a text file one line at a time without copying the file's
+//contents.  The file is memory-mapped and each line is given out as a pointer
+//into the mapping (without its line ending).
+//Gzipped files can't be mapped, so they are instead decompressed a batch at
+//a time into a buffer.  Files which can't be mapped for some other reason
+//are read into the buffer a batch at a time in the same way.  For this
+//reason, a line is only guaranteed to stay valid until the next call to
+//readLine or readBlock.
+class LineReader
+{
+public:
+    LineReader(QString fullFileName);
+    ~LineReader();
+
+    bool open();
+    void close();
+    bool atEnd() const;
+    bool hasError() const;
+    bool readLine(const char ** lineStart, int * lineLength);
+    bool readBlock(int minimumLength, char recordStart, const char ** blockStart, const char ** blockEnd);
+    void skipToEnd();
+    long long totalBytes() const;
+    long long bytesRead() const;
+    bool givesFileOffsets() const;
+    long long fileOffset(const char * position) const;
+
+private:
+    QFile m_file;
+    uchar * m_mapping;
+    GzipReader * m_gzipReader;
+    bool m_streaming;
+    bool m_readError;
+    QByteArray m_fallbackBuffer;
+    long long m_bufferFileOffset;
+    const char * m_start;
+    const char * m_position;
+    const char * m_end;
+
+    bool isBuffered() const {return m_gzipReader != 0 || m_streaming;}
+    bool readMore();
+};
+
+
+//These functions work directly on the bytes of a line, so the loaders can
+//tokenise lines without making a QString or QByteArray for every field.
+bool lineStartsWith(const char * lineStart, int lineLength, const char * prefix);
+int splitOnWhitespace(const char * lineStart, int lineLength,
+                      const char ** tokenStarts, int * tokenLengths, int maxTokens);
+long long parseLongLong(const char * start, int length, bool * ok = 0);
+double parseDouble(const char * start, int length, bool * ok = 0);
+
+
+//Sequence lines can have whitespace anywhere in them, not just at the ends,
+//and none of it is part of the sequence.  This is the same whitespace that
+//QString::simplified removes.
+inline bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+void appendWithoutWhitespace(const char * start, int length, QByteArray * destination);
+int countNonWhitespace(const char * start, int length);
+
+#endif // LINEREADER_H
@@ -30,9 +30,13 @@ Settings::Settings()
     segmentLength = 15.0;
     graphLayoutQuality = 2;
 
+    readTrackingMode = SKIP_READ_TRACKING;
+    sequenceLoadingMode = LOAD_SEQUENCES;
+
     averageNodeWidth = 5.0;
     coverageEffectOnWidth = 0.5;
     coveragePower = 0.5;
+    widthCoveragePercentileCap = 100;
 
     edgeWidth = 2.0;
     outlineThickness = 0.0;
@@ -82,6 +86,8 @@ Settings::Settings()
     noBlastHitsColour = QColor(230, 230, 230);
 
     autoCoverageValue = true;
+    lowCoveragePercentile = 25;
+    highCoveragePercentile = 75;
     lowCoverageValue = 5.0;
     lowCoverageColour = QColor(0, 0, 0);
     highCoverageValue = 50.0;
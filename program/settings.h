@@ -38,9 +38,13 @@ public:
     double segmentLength;
     int graphLayoutQuality;
 
+    ReadTrackingMode readTrackingMode;
+    SequenceLoadingMode sequenceLoadingMode;
+
     double averageNodeWidth;
     double coverageEffectOnWidth;
     double coveragePower;
+    int widthCoveragePercentileCap;
 
     double edgeWidth;
     double outlineThickness;
@@ -91,6 +95,8 @@ public:
 
 
     bool autoCoverageValue;
+    int lowCoveragePercentile;
+    int highCoveragePercentile;
     double lowCoverageValue;
     QColor lowCoverageColour;
     double highCoverageValue;
@@ -0,0 +1,191 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+//This program checks the reverse complement kernel against the
+//byte-at-a-time switch that Bandage used before it, then times the two.
+//It isn't part of the Bandage build.  To build and run it:
+//  qmake tests/reversecomplement_bench.pro && make && ./reversecomplement_bench
+//It exits with 1 if the two functions ever give different results.
+
+#include "../graph/reversecomplement.h"
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <stdio.h>
+#include <stdlib.h>
+
+//This is AssemblyGraph::getReverseComplement as it was before the kernel.
+static QByteArray oldReverseComplement(QByteArray forwardSequence)
+{
+    QByteArray reverseComplement;
+
+    for (int i = forwardSequence.length() - 1; i >= 0; --i)
+    {
+        char letter = forwardSequence.at(i);
+
+        switch (letter)
+        {
+        case 'A': reverseComplement.append('T'); break;
+        case 'T': reverseComplement.append('A'); break;
+        case 'G': reverseComplement.append('C'); break;
+        case 'C': reverseComplement.append('G'); break;
+        case 'a': reverseComplement.append('t'); break;
+        case 't': reverseComplement.append('a'); break;
+        case 'g': reverseComplement.append('c'); break;
+        case 'c': reverseComplement.append('g'); break;
+        case 'R': reverseComplement.append('Y'); break;
+        case 'Y': reverseComplement.append('R'); break;
+        case 'S': reverseComplement.append('S'); break;
+        case 'W': reverseComplement.append('W'); break;
+        case 'K': reverseComplement.append('M'); break;
+        case 'M': reverseComplement.append('K'); break;
+        case 'r': reverseComplement.append('y'); break;
+        case 'y': reverseComplement.append('r'); break;
+        case 's': reverseComplement.append('s'); break;
+        case 'w': reverseComplement.append('w'); break;
+        case 'k': reverseComplement.append('m'); break;
+        case 'm': reverseComplement.append('k'); break;
+        case 'B': reverseComplement.append('V'); break;
+        case 'D': reverseComplement.append('H'); break;
+        case 'H': reverseComplement.append('D'); break;
+        case 'V': reverseComplement.append('B'); break;
+        case 'b': reverseComplement.append('v'); break;
+        case 'd': reverseComplement.append('h'); break;
+        case 'h': reverseComplement.append('d'); break;
+        case 'v': reverseComplement.append('b'); break;
+        case 'N': reverseComplement.append('N'); break;
+        case 'n': reverseComplement.append('n'); break;
+        case '.': reverseComplement.append('.'); break;
+        case '-': reverseComplement.append('-'); break;
+        case '?': reverseComplement.append('?'); break;
+        }
+    }
+
+    return reverseComplement;
+}
+
+static QByteArray newReverseComplement(const QByteArray & forwardSequence)
+{
+    QByteArray reverseComplement(forwardSequence.length(), Qt::Uninitialized);
+    int length = reverseComplementSequence(forwardSequence.constData(), forwardSequence.length(),
+                                           reverseComplement.data());
+    reverseComplement.resize(length);
+    return reverseComplement;
+}
+
+
+//The equivalence check uses every character the old switch knows, plus
+//some it doesn't (which both functions should leave out), so the kernel's
+//handling of every character is compared.
+static QByteArray makeAnySequence(int length)
+{
+    static const char letters[] = "ACGTacgtRYSWKMrysw kmBDHVbdhvNn.-?XxZz*E\t\r\n0U";
+    int letterCount = int(sizeof(letters)) - 1;
+    QByteArray sequence(length, Qt::Uninitialized);
+    for (int i = 0; i < length; ++i)
+        sequence[i] = letters[rand() % letterCount];
+    return sequence;
+}
+
+//The timed sequence looks like real assembly output: mostly ACGT, with an
+//occasional N and lower case run.
+static QByteArray makeTypicalSequence(int length)
+{
+    static const char bases[] = "ACGT";
+    QByteArray sequence(length, Qt::Uninitialized);
+    for (int i = 0; i < length; ++i)
+    {
+        int r = rand() % 1000;
+        if (r == 0)
+            sequence[i] = 'N';
+        else if (r < 5)
+            sequence[i] = bases[rand() % 4] + ('a' - 'A');
+        else
+            sequence[i] = bases[rand() % 4];
+    }
+    return sequence;
+}
+
+
+static bool checkEquivalence()
+{
+    int mismatches = 0;
+    int checks = 0;
+
+    //Every length up to a few vectors long is tried, so the vector loops'
+    //tails are covered, then some longer sequences.
+    for (int length = 0; length <= 200; ++length)
+    {
+        for (int i = 0; i < 50; ++i)
+        {
+            QByteArray sequence = makeAnySequence(length);
+            if (oldReverseComplement(sequence) != newReverseComplement(sequence))
+                ++mismatches;
+            ++checks;
+        }
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        QByteArray sequence = makeAnySequence(rand() % 100000);
+        if (oldReverseComplement(sequence) != newReverseComplement(sequence))
+            ++mismatches;
+        ++checks;
+    }
+
+    printf("Equivalence: %d of %d random sequences differ\n", mismatches, checks);
+    return mismatches == 0;
+}
+
+
+static void timeFunctions()
+{
+    const int sequenceLength = 10000000;
+    const int repeats = 10;
+    QByteArray sequence = makeTypicalSequence(sequenceLength);
+
+    //The results' lengths are summed so the calls can't be optimised away.
+    long long total = 0;
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < repeats; ++i)
+        total += oldReverseComplement(sequence).length();
+    qint64 oldTime = timer.elapsed();
+
+    timer.start();
+    for (int i = 0; i < repeats; ++i)
+        total += newReverseComplement(sequence).length();
+    qint64 newTime = timer.elapsed();
+
+    double megabases = double(sequenceLength) * repeats / 1000000.0;
+    printf("Old switch: %lld ms (%.1f Mbp/s)\n", (long long)oldTime,
+           oldTime > 0 ? megabases * 1000.0 / oldTime : 0.0);
+    printf("Kernel:     %lld ms (%.1f Mbp/s)\n", (long long)newTime,
+           newTime > 0 ? megabases * 1000.0 / newTime : 0.0);
+    if (newTime > 0)
+        printf("Speedup:    %.1fx\n", double(oldTime) / newTime);
+    printf("(%lld bases)\n", total);
+}
+
+
+int main()
+{
+    srand(1);
+    if (!checkEquivalence())
+        return 1;
+    timeFunctions();
+    return 0;
+}
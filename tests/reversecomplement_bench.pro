@@ -0,0 +1,36 @@
+# Copyright 2015 Ryan Wick
+
+# This file is part of Bandage
+
+# Bandage is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+
+# Bandage is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+# This is a standalone benchmark for the reverse complement kernel.  It is
+# not part of Bandage.pro, so it is only built when asked for:
+#   qmake tests/reversecomplement_bench.pro && make
+
+QT       += core
+QT       -= gui
+
+TARGET = reversecomplement_bench
+TEMPLATE = app
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+SOURCES += \
+    reversecomplement_bench.cpp \
+    ../graph/reversecomplement.cpp
+
+HEADERS += \
+    ../graph/reversecomplement.h
@@ -122,10 +122,8 @@ void BlastSearchDialog::loadBlastHits(QString blastHits)
             continue;
 
         long long nodeNumber = getNodeNumberFromString(nodeLabel);
-        DeBruijnNode * node;
-        if (g_assemblyGraph->m_deBruijnGraphNodes.contains(nodeNumber))
-            node = g_assemblyGraph->m_deBruijnGraphNodes[nodeNumber];
-        else
+        DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.value(nodeNumber, 0);
+        if (node == 0)
             return;
 
         BlastQuery * query = g_blastSearch->m_blastQueries.getQueryFromName(queryName);
@@ -300,7 +298,7 @@ void BlastSearchDialog::loadBlastQueriesFromFastaFile()
     if (fullFileName != "") //User did not hit cancel
     {
         std::vector<QString> queryNames;
-        std::vector<QString> querySequences;
+        std::vector<QByteArray> querySequences;
         readFastaFile(fullFileName, &queryNames, &querySequences);
 
         for (size_t i = 0; i < queryNames.size(); ++i)
@@ -341,7 +339,7 @@ void BlastSearchDialog::enterQueryManually()
     {
         QString queryName = cleanQueryName(enterOneBlastQueryDialog.getName());
         g_blastSearch->m_blastQueries.addQuery(BlastQuery(queryName,
-                                                          enterOneBlastQueryDialog.getSequence()));
+                                                          enterOneBlastQueryDialog.getSequence().toLatin1()));
         fillQueriesTable();
         clearBlastHits();
     }
@@ -20,7 +20,6 @@
 #define BLASTSEARCHDIALOG_H
 
 #include <QDialog>
-#include <QMap>
 
 class DeBruijnNode;
 
@@ -38,7 +37,6 @@ public:
 
 private:
     Ui::BlastSearchDialog *ui;
-    QMap<long long, DeBruijnNode*> * m_deBruijnGraphNodes;
     QString m_makeblastdbCommand;
     QString m_blastnCommand;
 
@@ -0,0 +1,44 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HISTOGRAMDIALOG_H
+#define HISTOGRAMDIALOG_H
+
+#include <QDialog>
+
+
+namespace Ui {
+class HistogramDialog;
+}
+
+//This dialog shows the node length and coverage histograms which were made
+//when the graph was loaded.
+class HistogramDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit HistogramDialog(QWidget *parent = 0);
+    ~HistogramDialog();
+
+private:
+    Ui::HistogramDialog *ui;
+};
+
+
+#endif // HISTOGRAMDIALOG_H
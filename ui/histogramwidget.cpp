@@ -0,0 +1,104 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "histogramwidget.h"
+#include <QPainter>
+#include <QFontMetrics>
+#include "../program/globals.h"
+#include <math.h>
+
+HistogramWidget::HistogramWidget(QWidget *parent) : QWidget(parent)
+{
+    setMinimumSize(400, 150);
+}
+
+
+void HistogramWidget::setHistogram(const LogHistogram & histogram)
+{
+    m_histogram = histogram;
+    update();
+}
+
+
+void HistogramWidget::paintEvent(QPaintEvent * /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(0, 0, width(), height(), QBrush(Qt::white));
+
+    //Only the bins from the first to the last with anything in them are
+    //drawn, so the bars fill the width.
+    int firstBin = -1;
+    int lastBin = -1;
+    long long highestCount = 0;
+    for (int i = 0; i < m_histogram.binCount(); ++i)
+    {
+        long long count = m_histogram.binTotal(i);
+        if (count == 0)
+            continue;
+        if (firstBin < 0)
+            firstBin = i;
+        lastBin = i;
+        if (count > highestCount)
+            highestCount = count;
+    }
+    if (firstBin < 0)
+        return;
+
+    QFontMetrics fontMetrics(font());
+    double axisHeight = fontMetrics.height() + 4.0;
+    double plotHeight = height() - axisHeight;
+    double barWidth = double(width()) / (lastBin - firstBin + 1);
+
+    QBrush barBrush(QColor(80, 80, 200));
+    for (int i = firstBin; i <= lastBin; ++i)
+    {
+        double barHeight = plotHeight * m_histogram.binTotal(i) / highestCount;
+        painter.fillRect(QRectF((i - firstBin) * barWidth, plotHeight - barHeight, barWidth, barHeight), barBrush);
+    }
+
+    //A grid line is drawn at the start of every bin that begins at a power of
+    //ten.
+    QPen gridLinePen(QBrush(Qt::gray), 0.5);
+    painter.setPen(gridLinePen);
+    double lastLabelEnd = -1.0;
+    for (int i = firstBin; i <= lastBin; ++i)
+    {
+        double binStart = m_histogram.binStart(i);
+        if (binStart <= 0.0)
+            continue;
+        double powerOfTen = log10(binStart);
+        if (fabs(powerOfTen - floor(powerOfTen + 0.5)) > 1e-6)
+            continue;
+
+        double x = (i - firstBin) * barWidth;
+        painter.drawLine(QPointF(x, 0.0), QPointF(x, plotHeight));
+
+        QString label = formatDoubleForDisplay(binStart, 2);
+        double labelWidth = fontMetrics.width(label);
+        if (x > lastLabelEnd && x + labelWidth <= width())
+        {
+            painter.setPen(QPen(Qt::black));
+            painter.drawText(QPointF(x + 2.0, height() - 4.0), label);
+            painter.setPen(gridLinePen);
+            lastLabelEnd = x + labelWidth + 8.0;
+        }
+    }
+
+    painter.setPen(QPen(QBrush(QColor(50, 50, 50)), 0.5));
+    painter.drawLine(QPointF(0.0, plotHeight), QPointF(width(), plotHeight));
+}
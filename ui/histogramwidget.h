@@ -0,0 +1,42 @@
+//Copyright 2015 Ryan Wick
+
+//This file is part of Bandage
+
+//Bandage is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+
+//Bandage is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+
+//You should have received a copy of the GNU General Public License
+//along with Bandage.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef HISTOGRAMWIDGET_H
+#define HISTOGRAMWIDGET_H
+
+#include <QWidget>
+#include "../graph/loghistogram.h"
+
+//This widget draws a LogHistogram as bars on a log scale, with a grid line
+//and label at each power of ten.
+class HistogramWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit HistogramWidget(QWidget *parent = 0);
+
+    void setHistogram(const LogHistogram & histogram);
+
+protected:
+    void paintEvent(QPaintEvent *);
+
+private:
+    LogHistogram m_histogram;
+};
+
+#endif // HISTOGRAMWIDGET_H
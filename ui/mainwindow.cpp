@@ -40,11 +40,13 @@
 #include <QProgressDialog>
 #include <QThread>
 #include "../program/graphlayoutworker.h"
+#include "../program/graphloadworker.h"
 #include <QRegExp>
 #include <QMessageBox>
 #include <QInputDialog>
 #include <QShortcut>
 #include "aboutdialog.h"
+#include "histogramdialog.h"
 #include <QMainWindow>
 #include "blastsearchdialog.h"
 #include "../graph/assemblygraph.h"
@@ -54,15 +56,17 @@
 #include "../blast/blastsearch.h"
 #include "../graph/debruijnnode.h"
 #include "../graph/debruijnedge.h"
+#include "../graph/neighbourhoodsearch.h"
 #include "../graph/graphicsitemnode.h"
 #include "../graph/graphicsitemedge.h"
 #include "myprogressdialog.h"
+#include "../program/gzipreader.h"
 #include <limits>
 #include <QDesktopServices>
 
 MainWindow::MainWindow(QString filename) :
     QMainWindow(0),
-    ui(new Ui::MainWindow), m_layoutThread(0)
+    ui(new Ui::MainWindow), m_layoutThread(0), m_loadThread(0), m_graphLoadWorker(0)
 {
     ui->setupUi(this);
 
@@ -120,6 +124,7 @@ MainWindow::MainWindow(QString filename) :
     connect(ui->actionLoad_LastGraph, SIGNAL(triggered()), this, SLOT(loadLastGraph()));
     connect(ui->actionLoad_fastg, SIGNAL(triggered()), this, SLOT(loadFastg()));
     connect(ui->actionLoad_Trinity_fasta, SIGNAL(triggered()), this, SLOT(loadTrinityFasta()));
+    connect(ui->actionLoad_GFA, SIGNAL(triggered()), this, SLOT(loadGfa()));
     connect(ui->actionExit, SIGNAL(triggered()), this, SLOT(close()));
     connect(ui->graphScopeComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(graphScopeChanged()));
     connect(ui->zoomSpinBox, SIGNAL(valueChanged(double)), this, SLOT(zoomSpinBoxChanged()));
@@ -142,6 +147,7 @@ MainWindow::MainWindow(QString filename) :
     connect(ui->selectNodesButton, SIGNAL(clicked()), this, SLOT(selectUserSpecifiedNodes()));
     connect(ui->selectionSearchNodesLineEdit, SIGNAL(returnPressed()), this, SLOT(selectUserSpecifiedNodes()));
     connect(ui->actionAbout, SIGNAL(triggered()), this, SLOT(openAboutDialog()));
+    connect(ui->actionHistograms, SIGNAL(triggered()), this, SLOT(openHistogramDialog()));
     connect(ui->blastSearchButton, SIGNAL(clicked()), this, SLOT(openBlastSearchDialog()));
     connect(ui->blastQueryComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(blastTargetChanged()));
     connect(ui->actionControls_panel, SIGNAL(toggled(bool)), this, SLOT(showHidePanels()));
@@ -184,11 +190,23 @@ MainWindow::MainWindow(QString filename) :
             loadGraphFile2("FASTG", filename);
         else if (checkFileIsTrinityFasta(filename))
             loadGraphFile2("Trinity.fasta", filename);
+        else if (checkFileIsGfa(filename))
+            loadGraphFile2("GFA", filename);
     }
 }
 
 MainWindow::~MainWindow()
 {
+    //If a graph is still loading, stop it before deleting things.
+    if (m_graphLoadWorker != 0)
+    {
+        m_graphLoadWorker->cancel();
+        m_loadThread->quit();
+        m_loadThread->wait();
+        delete m_graphLoadWorker->m_assemblyGraph;
+        delete m_graphLoadWorker;
+    }
+
     cleanUp();
     delete m_graphicsViewZoom;
     delete g_assemblyGraph;
@@ -227,6 +245,11 @@ void MainWindow::loadTrinityFasta()
     loadGraphFile1("Trinity.fasta");
 }
 
+void MainWindow::loadGfa()
+{
+    loadGraphFile1("GFA");
+}
+
 
 void MainWindow::loadGraphFile1(QString graphFileType)
 {
@@ -242,7 +265,8 @@ void MainWindow::loadGraphFile2(QString graphFileType, QString fullFileName)
 {
     if ( (graphFileType == "LastGraph" && !checkFileIsLastGraph(fullFileName)) ||
          (graphFileType == "FASTG" && !checkFileIsFastG(fullFileName)) ||
-         (graphFileType == "Trinity.fasta" && !checkFileIsTrinityFasta(fullFileName)) )
+         (graphFileType == "Trinity.fasta" && !checkFileIsTrinityFasta(fullFileName)) ||
+         (graphFileType == "GFA" && !checkFileIsGfa(fullFileName)) )
     {
         QMessageBox::StandardButton reply;
         reply = QMessageBox::question(this, graphFileType + " file?",
@@ -257,503 +281,129 @@ void MainWindow::loadGraphFile2(QString graphFileType, QString fullFileName)
     cleanUp();
     ui->selectionSearchNodesLineEdit->clear();
 
-    try
-    {
-        if (graphFileType == "LastGraph")
-            buildDeBruijnGraphFromLastGraph(fullFileName);
-        else if (graphFileType == "FASTG")
-            buildDeBruijnGraphFromFastg(fullFileName);
-        else if (graphFileType == "Trinity.fasta")
-            buildDeBruijnGraphFromTrinityFasta(fullFileName);
-
-        enableDisableUiElements(GRAPH_LOADED);
-        setWindowTitle("Bandage - " + fullFileName);
-
-        g_assemblyGraph->determineGraphInfo();
-        displayGraphDetails();
-        g_settings->rememberedPath = QFileInfo(fullFileName).absolutePath();
-    }
-
-    catch (...)
-    {
-        QMessageBox::warning(this, "Error loading " + graphFileType,
-                             "There was an error when attempting to load:\n"
-                             + fullFileName + "\n\n"
-                             "Please verify that this file has the correct format.");
-        resetScene();
-        cleanUp();
-        clearGraphDetails();
-        enableDisableUiElements(NO_GRAPH_LOADED);
-    }
-}
-
-
-
-
-void MainWindow::buildDeBruijnGraphFromLastGraph(QString fullFileName)
-{
-    MyProgressDialog progress(this, "Loading LastGraph file...", false);
-    progress.setWindowModality(Qt::WindowModal);
-    progress.show();
-
-    g_assemblyGraph->m_trinityGraph = false;
-
-    QFile inputFile(fullFileName);
-    if (inputFile.open(QIODevice::ReadOnly))
-    {
-        QTextStream in(&inputFile);
-        while (!in.atEnd())
-        {
-            QApplication::processEvents();
-            QString line = in.readLine();
-            if (line.startsWith("NODE"))
-            {
-                QStringList nodeDetails = line.split(QRegExp("\\s+"));
-
-                if (nodeDetails.size() < 4)
-                    throw "load error";
-
-                long long nodeNumber = nodeDetails.at(1).toLongLong();
-                int nodeLength = nodeDetails.at(2).toInt();
-
-                double nodeCoverage;
-                if (nodeLength > 0)
-                    nodeCoverage = double(nodeDetails.at(3).toInt()) / nodeLength; //IS THIS COLUMN ($COV_SHORT1) THE BEST ONE TO USE?
-                else
-                    nodeCoverage = double(nodeDetails.at(3).toInt());
-
-                QByteArray sequence = in.readLine().toLocal8Bit();
-                QByteArray revCompSequence = in.readLine().toLocal8Bit();
-
-                DeBruijnNode * node = new DeBruijnNode(nodeNumber, nodeLength, nodeCoverage, sequence);
-                DeBruijnNode * reverseComplementNode = new DeBruijnNode(-nodeNumber, nodeLength, nodeCoverage, revCompSequence);
-                node->m_reverseComplement = reverseComplementNode;
-                reverseComplementNode->m_reverseComplement = node;
-                g_assemblyGraph->m_deBruijnGraphNodes.insert(nodeNumber, node);
-                g_assemblyGraph->m_deBruijnGraphNodes.insert(-nodeNumber, reverseComplementNode);
-            }
-            else if (line.startsWith("ARC"))
-            {
-                QStringList arcDetails = line.split(QRegExp("\\s+"));
-
-                if (arcDetails.size() < 3)
-                    throw "load error";
-
-                long long node1Number = arcDetails.at(1).toLongLong();
-                long long node2Number = arcDetails.at(2).toLongLong();
-
-                g_assemblyGraph->createDeBruijnEdge(node1Number, node2Number);
-            }
-        }
-        inputFile.close();
-    }
-
-    if (g_assemblyGraph->m_deBruijnGraphNodes.size() == 0)
-        throw "load error";
-}
-
-
-
-
-void MainWindow::buildDeBruijnGraphFromFastg(QString fullFileName)
-{
-    MyProgressDialog progress(this, "Loading FASTG file...", false);
-    progress.setWindowModality(Qt::WindowModal);
-    progress.show();
-
-    g_assemblyGraph->m_trinityGraph = false;
-
-    QFile inputFile(fullFileName);
-    if (inputFile.open(QIODevice::ReadOnly))
-    {
-        std::vector<long long> edgeStartingNodeNumbers;
-        std::vector<long long> edgeEndingNodeNumbers;
-        DeBruijnNode * node = 0;
-
-        QTextStream in(&inputFile);
-        while (!in.atEnd())
-        {
-            QApplication::processEvents();
-
-            long long nodeNumber;
-            int nodeLength;
-            double nodeCoverage;
-
-            QString line = in.readLine();
-
-            //If the line starts with a '>', then we are beginning a new node.
-            if (line.startsWith(">"))
-            {
-                line.remove(0, 1); //Remove '>' from start
-                line.chop(1); //Remove ';' from end
-                QStringList nodeDetails = line.split(":");
-
-                QString thisNode = nodeDetails.at(0);
-
-                //A single quote as the last character indicates a negative node.
-                bool negativeNode = thisNode.at(thisNode.size() - 1) == '\'';
-
-                QStringList thisNodeDetails = thisNode.split("_");
-
-                if (thisNodeDetails.size() < 6)
-                    throw "load error";
-
-                nodeNumber = thisNodeDetails.at(1).toLongLong();
-                nodeLength = thisNodeDetails.at(3).toInt();
-
-                QString nodeCoverageString = thisNodeDetails.at(5);
-                if (negativeNode)
-                {
-                    //It may be necessary to remove a single quote from the end of the coverage
-                    if (nodeCoverageString.at(nodeCoverageString.size() - 1) == '\'')
-                        nodeCoverageString.chop(1);
-
-                    nodeNumber *= -1;
-                }
-                nodeCoverage = nodeCoverageString.toDouble();
-
-                //Make the node
-                node = new DeBruijnNode(nodeNumber, nodeLength, nodeCoverage, ""); //Sequence string is currently empty - will be added to on subsequent lines of the fastg file
-                g_assemblyGraph->m_deBruijnGraphNodes.insert(nodeNumber, node);
-
-                //The second part of nodeDetails is a comma-delimited list of edge nodes.
-                //Edges aren't made right now (because the other node might not yet exist),
-                //so they are saved into vectors and made after all the nodes have been made.
-                if (nodeDetails.size() == 1)
-                    continue;
-                QStringList edgeNodes = nodeDetails.at(1).split(",");
-                for (int i = 0; i < edgeNodes.size(); ++i)
-                {
-                    QString edgeNode = edgeNodes.at(i);
-
-                    QChar lastChar = edgeNode.at(edgeNode.size() - 1);
-                    bool reverseComplement = false;
-                    if (lastChar == '\'')
-                    {
-                        reverseComplement = true;
-                        edgeNode.chop(1);
-                    }
-                    QStringList edgeNodeDetails = edgeNode.split("_");
-
-                    if (edgeNodeDetails.size() < 2)
-                        throw "load error";
-
-                    int edgeNodeNumber = edgeNodeDetails.at(1).toInt();
-                    if (reverseComplement)
-                        edgeNodeNumber *= -1;
-
-                    edgeStartingNodeNumbers.push_back(nodeNumber);
-                    edgeEndingNodeNumbers.push_back(edgeNodeNumber);
-                }
-            }
-
-            //If the line does not start with a '>', then this line is part of the
-            //sequence for the last node.
-            else
-            {
-                QByteArray sequenceLine = line.simplified().toLocal8Bit();
-                if (node != 0)
-                    node->m_sequence.append(sequenceLine);
-            }
-        }
-
-        inputFile.close();
-
-        //If all went well, each node will have a reverse complement and the code
-        //will never get here.  However, I have noticed that some SPAdes fastg files
-        //have, for some reason, negative nodes with no positive counterpart.  For
-        //that reason, we will now make any reverse complement nodes for nodes that
-        //lack them.
-        QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-        while (i.hasNext())
-        {
-            i.next();
-            DeBruijnNode * node = i.value();
-            makeReverseComplementNodeIfNecessary(node);
-        }
-        pointEachNodeToItsReverseComplement();
-
+    //The graph is built in a different thread so the UI will stay responsive.
+    MyProgressDialog * progress = new MyProgressDialog(this, "Loading " + graphFileType + " file...", true);
+    progress->setCancelButton("Cancel loading", "Cancelling loading...",
+                              "Clicking this button will stop loading the graph.");
+    progress->setMaxValue(1000);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->show();
 
-        //Create all of the edges
-        for (size_t i = 0; i < edgeStartingNodeNumbers.size(); ++i)
-        {
-            long long node1Number = edgeStartingNodeNumbers[i];
-            long long node2Number = edgeEndingNodeNumbers[i];
-            g_assemblyGraph->createDeBruijnEdge(node1Number, node2Number);
-        }
-    }
+    m_loadThread = new QThread;
+    m_graphLoadWorker = new GraphLoadWorker(graphFileType, fullFileName);
+    m_graphLoadWorker->moveToThread(m_loadThread);
 
-    if (g_assemblyGraph->m_deBruijnGraphNodes.size() == 0)
-        throw "load error";
+    connect(progress, SIGNAL(halt()), m_graphLoadWorker, SLOT(cancel()), Qt::DirectConnection);
+    connect(m_graphLoadWorker, SIGNAL(progressChanged(int)), progress, SLOT(setValue(int)));
+    connect(m_loadThread, SIGNAL(started()), m_graphLoadWorker, SLOT(loadGraph()));
+    connect(m_graphLoadWorker, SIGNAL(finishedLoading()), m_loadThread, SLOT(quit()));
+    connect(m_graphLoadWorker, SIGNAL(finishedLoading()), this, SLOT(graphLoadFinished()));
+    connect(m_loadThread, SIGNAL(finished()), m_loadThread, SLOT(deleteLater()));
+    connect(m_loadThread, SIGNAL(finished()), progress, SLOT(deleteLater()));
+    m_loadThread->start();
 }
 
 
-void MainWindow::buildDeBruijnGraphFromTrinityFasta(QString fullFileName)
+//When the worker finishes, its graph (if it has one) replaces the current,
+//empty graph in one step.
+void MainWindow::graphLoadFinished()
 {
-    MyProgressDialog progress(this, "Loading Trinity.fasta file...", false);
-    progress.setWindowModality(Qt::WindowModal);
-    progress.show();
+    m_loadThread->wait();
+    m_loadThread = 0;
 
-    g_assemblyGraph->m_trinityGraph = true;
+    QString graphFileType = m_graphLoadWorker->m_graphFileType;
+    QString fullFileName = m_graphLoadWorker->m_fullFileName;
+    AssemblyGraph * loadedGraph = m_graphLoadWorker->m_assemblyGraph;
+    bool succeeded = m_graphLoadWorker->m_succeeded;
+    bool cancelled = m_graphLoadWorker->isCancelled();
+    delete m_graphLoadWorker;
+    m_graphLoadWorker = 0;
 
-    std::vector<QString> names;
-    std::vector<QString> sequences;
-    readFastaFile(fullFileName, &names, &sequences);
-
-    std::vector<long long> edgeStartingNodeNumbers;
-    std::vector<long long> edgeEndingNodeNumbers;
-
-    for (size_t i = 0; i < names.size(); ++i)
+    if (succeeded)
     {
-        QString name = names[i];
-        QString sequence = sequences[i];
-
-        //The header can come in a couple of different formats.
-        //I need the transcript number and the component number.  Some
-        //of the formats don't seem to include the transcript number,
-        //so I use 0 in those cases.
-        int transcript;
-        int component;
-
-        if (name.length() < 4)
-            throw "load error";
-
-        // This is for header formats like this:
-        // TR1|c0_g1_i1 len=280 path=[274:0-228 275:229-279] [-1, 274, 275, -2]
-        if (name.mid(0, 2) == "TR")
-        {
-            int transcriptStartIndex = name.indexOf("TR") + 2;
-            int transcriptEndIndex = name.indexOf("|", transcriptStartIndex);
-            if (transcriptStartIndex < 0 || transcriptEndIndex < 0)
-                throw "load error";
-            int transcriptLength = transcriptEndIndex - transcriptStartIndex;
-            transcript = name.mid(transcriptStartIndex, transcriptLength).toInt();
-
-            int componentStartIndex = name.indexOf("|c") + 2;
-            int componentEndIndex = name.indexOf("_", componentStartIndex);
-            if (componentStartIndex < 0 || componentEndIndex < 0)
-                throw "load error";
-            int componentLength = componentEndIndex - componentStartIndex;
-            component = name.mid(componentStartIndex, componentLength).toInt();
-        }
-
-        // This is for header formats like this:
-        // GG1|c0_g1_i1 len=302 path=[1:0-301]
-        else if (name.mid(0, 2) == "GG")
-        {
-            int transcriptStartIndex = name.indexOf("GG") + 2;
-            int transcriptEndIndex = name.indexOf("|", transcriptStartIndex);
-            if (transcriptStartIndex < 0 || transcriptEndIndex < 0)
-                throw "load error";
-            int transcriptLength = transcriptEndIndex - transcriptStartIndex;
-            transcript = name.mid(transcriptStartIndex, transcriptLength).toInt();
-
-            int componentStartIndex = name.indexOf("|c") + 2;
-            int componentEndIndex = name.indexOf("_", componentStartIndex);
-            if (componentStartIndex < 0 || componentEndIndex < 0)
-                throw "load error";
-            int componentLength = componentEndIndex - componentStartIndex;
-            component = name.mid(componentStartIndex, componentLength).toInt();
-        }
-
-        // This is for header formats like this:
-        // comp0_c0_seq1 len=286 path=[6:0-285]
-        else if (name.mid(0, 4) == "comp")
-        {
-            transcript = 0;
-
-            int componentStartIndex = name.indexOf("comp") + 4;
-            int componentEndIndex = name.indexOf("_", componentStartIndex);
-            if (componentStartIndex < 0 || componentEndIndex < 0)
-                throw "load error";
-            int componentLength = componentEndIndex - componentStartIndex;
-            component = name.mid(componentStartIndex, componentLength).toInt();
-        }
-
-        // This is for header formats like this:
-        // c0_g1_i1 len=363 path=[119:0-185 43:186-244 43:245-303 43:304-362]
-        else if (name.at(0) == 'c' && name.at(1).isDigit())
-        {
-            transcript = 0;
-
-            int componentStartIndex = 1;
-            int componentEndIndex = name.indexOf("_", componentStartIndex);
-            if (componentStartIndex < 0 || componentEndIndex < 0)
-                throw "load error";
-            int componentLength = componentEndIndex - componentStartIndex;
-            component = name.mid(componentStartIndex, componentLength).toInt();
-        }
-
-        //If the header doesn't match any of the previous options, then
-        //I don't know what's going on.
-        else
-            throw "load error";
-
-
-        int pathStartIndex = name.indexOf("path=[") + 6;
-        int pathEndIndex = name.indexOf("]", pathStartIndex);
-        if (pathStartIndex < 0 || pathEndIndex < 0)
-            throw "load error";
-        int pathLength = pathEndIndex - pathStartIndex;
-        QString path = name.mid(pathStartIndex, pathLength);
-        if (path.size() == 0)
-            throw "load error";
-
-        QStringList pathParts = path.split(" ");
-
-        //Each path part is a node
-        long long previousNodeNumber = 0;
-        for (int i = 0; i < pathParts.length(); ++i)
-        {
-            QString pathPart = pathParts.at(i);
-            QStringList nodeParts = pathPart.split(":");
-            if (nodeParts.size() < 2)
-                throw "load error";
-
-            //Most node numbers will be formatted simply as the number, but some
-            //(I don't know why) have '@' and the start and '@!' at the end.  In
-            //these cases, we must strip those extra characters off.
-            QString nodeNumberString = nodeParts.at(0);
-            if (nodeNumberString.at(0) == '@')
-                nodeNumberString = nodeNumberString.mid(1, nodeNumberString.length() - 3);
-
-            long long nodeNumber = nodeNumberString.toLongLong();
-            nodeNumber = getFullTrinityNodeNumberFromParts(transcript, component, nodeNumber);
-
-            //If the node doesn't yet exist, make it now.
-            if (!g_assemblyGraph->m_deBruijnGraphNodes.contains(nodeNumber))
-            {
-                QString nodeRange = nodeParts.at(1);
-                QStringList nodeRangeParts = nodeRange.split("-");
-
-                if (nodeRangeParts.size() < 2)
-                    throw "load error";
-
-                int nodeRangeStart = nodeRangeParts.at(0).toInt();
-                int nodeRangeEnd = nodeRangeParts.at(1).toInt();
-                int nodeLength = nodeRangeEnd - nodeRangeStart + 1;
-
-                QByteArray nodeSequence = sequence.mid(nodeRangeStart, nodeLength).toLocal8Bit();
-                DeBruijnNode * node = new DeBruijnNode(nodeNumber, nodeLength, 0.0, nodeSequence);
-                g_assemblyGraph->m_deBruijnGraphNodes.insert(nodeNumber, node);
-            }
-
-            //Remember to make an edge for the previous node to this one.
-            if (i > 0)
-            {
-                edgeStartingNodeNumbers.push_back(previousNodeNumber);
-                edgeEndingNodeNumbers.push_back(nodeNumber);
-            }
-            previousNodeNumber = nodeNumber;
-        }
-    }
+        delete g_assemblyGraph;
+        g_assemblyGraph = loadedGraph;
 
-    //Even though the Trinity.fasta file only contains positive nodes, Bandage
-    //expects negative reverse complements nodes, so make them now.
-    QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (i.hasNext())
-    {
-        i.next();
-        DeBruijnNode * node = i.value();
-        makeReverseComplementNodeIfNecessary(node);
-    }
-    pointEachNodeToItsReverseComplement();
+        enableDisableUiElements(GRAPH_LOADED);
+        setWindowTitle("Bandage - " + fullFileName);
 
-    //Create all of the edges.  The createDeBruijnEdge function checks for
-    //duplicates, so it's okay if we try to add the same edge multiple times.
-    for (size_t i = 0; i < edgeStartingNodeNumbers.size(); ++i)
-    {
-        long long node1Number = edgeStartingNodeNumbers[i];
-        long long node2Number = edgeEndingNodeNumbers[i];
-        g_assemblyGraph->createDeBruijnEdge(node1Number, node2Number);
+        g_assemblyGraph->setAutoBasePairsPerSegment();
+        displayGraphDetails();
+        g_settings->rememberedPath = QFileInfo(fullFileName).absolutePath();
     }
 
-    if (g_assemblyGraph->m_deBruijnGraphNodes.size() == 0)
-        throw "load error";
-}
-
-
-void MainWindow::makeReverseComplementNodeIfNecessary(DeBruijnNode * node)
-{
-    long long  reverseComplementNumber = -node->m_number;
-    DeBruijnNode * reverseComplementNode = g_assemblyGraph->m_deBruijnGraphNodes[reverseComplementNumber];
-    if (reverseComplementNode == 0)
+    else
     {
-        DeBruijnNode * newNode = new DeBruijnNode(reverseComplementNumber, node->m_length, node->m_coverage,
-                                                  g_assemblyGraph->getReverseComplement(node->m_sequence));
-        g_assemblyGraph->m_deBruijnGraphNodes.insert(reverseComplementNumber, newNode);
+        if (!cancelled)
+            QMessageBox::warning(this, "Error loading " + graphFileType,
+                                 "There was an error when attempting to load:\n"
+                                 + fullFileName + "\n\n"
+                                 "Please verify that this file has the correct format.");
+        resetScene();
+        cleanUp();
+        clearGraphDetails();
+        enableDisableUiElements(NO_GRAPH_LOADED);
     }
 }
 
 
-void MainWindow::pointEachNodeToItsReverseComplement()
-{
-    QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (i.hasNext())
-    {
-        i.next();
-        DeBruijnNode * positiveNode = i.value();
-
-        if (positiveNode->m_number > 0)
-        {
-            DeBruijnNode * negativeNode = g_assemblyGraph->m_deBruijnGraphNodes[-(positiveNode->m_number)];
-            if (negativeNode != 0)
-            {
-                positiveNode->m_reverseComplement = negativeNode;
-                negativeNode->m_reverseComplement = positiveNode;
-            }
-        }
-    }
-}
 
 
 void MainWindow::buildOgdfGraphFromNodesAndEdges()
 {
     if (g_settings->graphScope == WHOLE_GRAPH)
     {
-        QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-        while (i.hasNext())
+        //If double mode is off, only positive nodes are drawn.  If it's
+        //on, all nodes are drawn.
+        const long long * numbers = g_assemblyGraph->m_nodeColumns.m_number.data();
+        for (int i = 0; i < g_assemblyGraph->m_nodeColumns.size(); ++i)
         {
-            i.next();
-
-            //If double mode is off, only positive nodes are drawn.  If it's
-            //on, all nodes are drawn.
-            if (i.value()->m_number > 0 || g_settings->doubleMode)
-                i.value()->m_drawn = true;
+            if (numbers[i] > 0 || g_settings->doubleMode)
+                g_assemblyGraph->m_deBruijnGraphNodes.at(i)->setDrawn(true);
         }
     }
     else //The scope is either around specified nodes or around nodes with BLAST hits
     {
         std::vector<DeBruijnNode *> startingNodes;
 
-        if (g_settings->graphScope == AROUND_NODE)
+        if (g_settings->graphScope == AROUND_NODE || g_settings->graphScope == AROUND_NODE_BASE_PAIRS)
             startingNodes = getNodesFromLineEdit(ui->startingNodesLineEdit);
         else if (g_settings->graphScope == AROUND_BLAST_HITS)
             startingNodes = getNodesFromBlastHits();
 
-        int nodeDistance = ui->nodeDistanceSpinBox->value();
-
         for (size_t i = 0; i < startingNodes.size(); ++i)
         {
-            DeBruijnNode * node = startingNodes[i];
-
             //If we are in single mode, make sure that each node is positive.
+            if (!g_settings->doubleMode && startingNodes[i]->m_number < 0)
+                startingNodes[i] = startingNodes[i]->m_reverseComplement;
+
+            startingNodes[i]->m_startingNode = true;
+        }
+
+        //The search follows the nodes' own edges, but in single mode it is
+        //the positive node of each pair which is drawn.
+        std::vector<int> nodesInRange;
+        if (g_settings->graphScope == AROUND_NODE_BASE_PAIRS)
+            findNodesWithinBasePairs(g_assemblyGraph->m_deBruijnGraphNodes, startingNodes,
+                                     ui->basePairDistanceSpinBox->value(), &nodesInRange);
+        else
+            findNodesWithinDistance(g_assemblyGraph->m_deBruijnGraphNodes, startingNodes,
+                                    ui->nodeDistanceSpinBox->value(), &nodesInRange);
+        for (size_t i = 0; i < nodesInRange.size(); ++i)
+        {
+            DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.at(nodesInRange[i]);
             if (!g_settings->doubleMode && node->m_number < 0)
                 node = node->m_reverseComplement;
-
-            node->m_drawn = true;
-            node->m_startingNode = true;
-            node->labelNeighbouringNodesAsDrawn(nodeDistance, 0);
+            node->setDrawn(true);
         }
     }
 
     //First loop through each node, adding it to OGDF if it is drawn.
-    QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (i.hasNext())
+    const char * drawn = g_assemblyGraph->m_nodeColumns.m_drawn.data();
+    for (int i = 0; i < g_assemblyGraph->m_nodeColumns.size(); ++i)
     {
-        i.next();
-        if (i.value()->m_drawn)
-            i.value()->addToOgdfGraph(g_assemblyGraph->m_ogdfGraph);
+        if (drawn[i])
+            g_assemblyGraph->m_deBruijnGraphNodes.at(i)->addToOgdfGraph(g_assemblyGraph->m_ogdfGraph, &g_assemblyGraph->m_ogdfNodes);
     }
 
     //Then loop through each determining its drawn status and adding it
@@ -762,7 +412,7 @@ void MainWindow::buildOgdfGraphFromNodesAndEdges()
     {
         g_assemblyGraph->m_deBruijnGraphEdges[i]->determineIfDrawn();
         if (g_assemblyGraph->m_deBruijnGraphEdges[i]->m_drawn)
-            g_assemblyGraph->m_deBruijnGraphEdges[i]->addToOgdfGraph(g_assemblyGraph->m_ogdfGraph);
+            g_assemblyGraph->m_deBruijnGraphEdges[i]->addToOgdfGraph(g_assemblyGraph->m_ogdfGraph, g_assemblyGraph->m_ogdfNodes);
     }
 }
 
@@ -786,21 +436,60 @@ bool MainWindow::checkFileIsTrinityFasta(QString fullFileName)
     return checkFirstLineOfFile(fullFileName, "path=\\[");
 }
 
+//Cursory look to see if file appears to be a GFA file.  GFA files can begin
+//with comment lines and with any type of record.
+bool MainWindow::checkFileIsGfa(QString fullFileName)
+{
+    return checkFirstLineOfFile(fullFileName, "^[HSLCPW]\\t", true);
+}
 
-bool MainWindow::checkFirstLineOfFile(QString fullFileName, QString regExp)
+
+//Only the first few KB of the file are read (and decompressed, if it is
+//gzipped), which is plenty for the first line of any of the graph formats.
+//If skipComments is true, empty lines and lines beginning with '#' are
+//passed over and the first line after them is checked.
+bool MainWindow::checkFirstLineOfFile(QString fullFileName, QString regExp, bool skipComments)
 {
     QFile inputFile(fullFileName);
-    if (inputFile.open(QIODevice::ReadOnly))
+    if (!inputFile.open(QIODevice::ReadOnly))
+        return false;
+
+    QByteArray fileStart;
+    if (GzipReader::isGzipFile(&inputFile))
     {
-        QTextStream in(&inputFile);
-        if (in.atEnd())
+        if (!GzipReader::readStart(&inputFile, 4096, &fileStart))
             return false;
-        QRegExp rx(regExp);
-        QString line = in.readLine();
-        if (rx.indexIn(line) != -1)
-            return true;
     }
-    return false;
+    else
+        fileStart = inputFile.read(4096);
+
+    if (fileStart.isEmpty())
+        return false;
+
+    int lineStart = 0;
+    int lineLength;
+    while (true)
+    {
+        int lineEnd = fileStart.indexOf('\n', lineStart);
+        if (lineEnd < 0)
+            lineEnd = fileStart.size();
+        lineLength = lineEnd - lineStart;
+        if (lineLength > 0 && fileStart.at(lineStart + lineLength - 1) == '\r')
+            --lineLength;
+
+        bool isComment = lineLength == 0 || fileStart.at(lineStart) == '#';
+        if (!skipComments || !isComment)
+            break;
+
+        //If the comments fill all of the start of the file, there is no
+        //record to check.
+        if (lineEnd >= fileStart.size())
+            return false;
+        lineStart = lineEnd + 1;
+    }
+
+    QRegExp rx(regExp);
+    return rx.indexIn(QString::fromLatin1(fileStart.constData() + lineStart, lineLength)) != -1;
 }
 
 
@@ -810,12 +499,25 @@ void MainWindow::displayGraphDetails()
     ui->nodeCountLabel->setText(formatIntForDisplay(g_assemblyGraph->m_nodeCount));
     ui->edgeCountLabel->setText(formatIntForDisplay(g_assemblyGraph->m_edgeCount));
     ui->totalLengthLabel->setText(formatIntForDisplay(g_assemblyGraph->m_totalLength));
+    ui->n50Label->setText(formatIntForDisplay(g_assemblyGraph->m_n50));
+    ui->n90Label->setText(formatIntForDisplay(g_assemblyGraph->m_n90));
+    ui->l50Label->setText(formatIntForDisplay(g_assemblyGraph->m_l50));
+    ui->medianCoverageLabel->setText(formatDoubleForDisplay(g_assemblyGraph->m_medianWeightedCoverage, 1));
+    if (g_assemblyGraph->m_gcContent < 0.0)
+        ui->gcContentLabel->setText("n/a");
+    else
+        ui->gcContentLabel->setText(formatDoubleForDisplay(100.0 * g_assemblyGraph->m_gcContent, 1) + "%");
 }
 void MainWindow::clearGraphDetails()
 {
     ui->nodeCountLabel->setText("0");
     ui->edgeCountLabel->setText("0");
     ui->totalLengthLabel->setText("0");
+    ui->n50Label->setText("0");
+    ui->n90Label->setText("0");
+    ui->l50Label->setText("0");
+    ui->medianCoverageLabel->setText("0");
+    ui->gcContentLabel->setText("n/a");
 }
 
 
@@ -838,22 +540,30 @@ void MainWindow::selectionChanged()
         QString selectedNodeCountText;
         QString selectedNodeListText;
         QString selectedNodeLengthText;
+        QString selectedNodeReadCountText;
 
-        getSelectedNodeInfo(selectedNodeCount, selectedNodeCountText, selectedNodeListText, selectedNodeLengthText);
+        getSelectedNodeInfo(selectedNodeCount, selectedNodeCountText, selectedNodeListText, selectedNodeLengthText,
+                            selectedNodeReadCountText);
 
         if (selectedNodeCount == 1)
         {
             ui->selectedNodesTitleLabel->setText("Selected node");
             ui->removeNodeButton->setText("Remove node");
             ui->selectedContigLengthLabel->setText("Length: " + selectedNodeLengthText);
+            ui->selectedNodesReadCountLabel->setText("Reads: " + selectedNodeReadCountText);
         }
         else
         {
             ui->selectedNodesTitleLabel->setText("Selected nodes (" + selectedNodeCountText + ")");
             ui->removeNodeButton->setText("Remove nodes");
             ui->selectedContigLengthLabel->setText("Total length: " + selectedNodeLengthText);
+            ui->selectedNodesReadCountLabel->setText("Total reads: " + selectedNodeReadCountText);
         }
 
+        //Read counts are only known for LastGraph files loaded with their
+        //read tracking.
+        ui->selectedNodesReadCountLabel->setVisible(!selectedNodeReadCountText.isEmpty());
+
         ui->selectedNodesTextEdit->setPlainText(selectedNodeListText);
     }
 
@@ -878,7 +588,8 @@ void MainWindow::selectionChanged()
 }
 
 
-void MainWindow::getSelectedNodeInfo(int & selectedNodeCount, QString & selectedNodeCountText, QString & selectedNodeListText, QString & selectedNodeLengthText)
+void MainWindow::getSelectedNodeInfo(int & selectedNodeCount, QString & selectedNodeCountText, QString & selectedNodeListText, QString & selectedNodeLengthText,
+                                     QString & selectedNodeReadCountText)
 {
     std::vector<DeBruijnNode *> selectedNodes = m_scene->getSelectedNodes();
 
@@ -886,6 +597,7 @@ void MainWindow::getSelectedNodeInfo(int & selectedNodeCount, QString & selected
     selectedNodeCountText = formatIntForDisplay(selectedNodeCount);
 
     long long totalLength = 0;
+    long long totalReadCount = 0;
 
     for (int i = 0; i < selectedNodeCount; ++i)
     {
@@ -894,9 +606,14 @@ void MainWindow::getSelectedNodeInfo(int & selectedNodeCount, QString & selected
             selectedNodeListText += ", ";
 
         totalLength += selectedNodes[i]->m_length;
+        totalReadCount += g_assemblyGraph->getNodeReadCount(selectedNodes[i]);
     }
 
     selectedNodeLengthText = formatIntForDisplay(totalLength);
+
+    //If the graph has no reads, the read count text is left empty.
+    if (!g_assemblyGraph->m_readPositions.isEmpty())
+        selectedNodeReadCountText = formatIntForDisplay(totalReadCount);
 }
 
 
@@ -957,6 +674,8 @@ void MainWindow::graphScopeChanged()
         ui->nodeSelectionWidget->setEnabled(true);
         ui->distanceWidget->setVisible(true);
         ui->distanceWidget->setEnabled(true);
+        ui->nodeDistanceSpinBox->setVisible(true);
+        ui->basePairDistanceSpinBox->setVisible(false);
         ui->nodeDistanceInfoText->setInfoText("Nodes will be drawn if they are specified in the above list or are "
                                               "within this many steps of those nodes.<br><br>"
                                               "A value of 0 will result in only the specified nodes being drawn. "
@@ -964,10 +683,29 @@ void MainWindow::graphScopeChanged()
                                               "the specified nodes being drawn.");
         break;
     case 2:
+        g_settings->graphScope = AROUND_NODE_BASE_PAIRS;
+        ui->nodeSelectionWidget->setVisible(true);
+        ui->nodeSelectionWidget->setEnabled(true);
+        ui->distanceWidget->setVisible(true);
+        ui->distanceWidget->setEnabled(true);
+        ui->nodeDistanceSpinBox->setVisible(false);
+        ui->basePairDistanceSpinBox->setVisible(true);
+        ui->nodeDistanceInfoText->setInfoText("Nodes will be drawn if they are specified in the above list or are "
+                                              "within this many base pairs of those nodes. The distance to a node "
+                                              "is the total length of the nodes between it and the nearest "
+                                              "specified node, so a node's own length doesn't count.<br><br>"
+                                              "A value of 0 will result in the specified nodes and their "
+                                              "neighbours being drawn. Unlike a distance in steps, this "
+                                              "limits the amount of sequence around the specified nodes "
+                                              "whether the nodes are short or long.");
+        break;
+    case 3:
         g_settings->graphScope = AROUND_BLAST_HITS;
         ui->nodeSelectionWidget->setVisible(false);
         ui->distanceWidget->setVisible(true);
         ui->distanceWidget->setEnabled(true);
+        ui->nodeDistanceSpinBox->setVisible(true);
+        ui->basePairDistanceSpinBox->setVisible(false);
         ui->nodeDistanceInfoText->setInfoText("Nodes will be drawn if they contain a BLAST hit or are within this "
                                               "many steps of nodes with a BLAST hit.<br><br>"
                                               "A value of 0 will result in only nodes with BLAST hits being drawn. "
@@ -981,7 +719,7 @@ void MainWindow::graphScopeChanged()
 
 void MainWindow::drawGraph()
 {
-    if (g_settings->graphScope == AROUND_NODE)
+    if (g_settings->graphScope == AROUND_NODE || g_settings->graphScope == AROUND_NODE_BASE_PAIRS)
     {
         std::vector<DeBruijnNode *> startingNodes = getNodesFromLineEdit(ui->startingNodesLineEdit);
 
@@ -1072,10 +810,13 @@ std::vector<DeBruijnNode *> MainWindow::getNodesFromLineEdit(QLineEdit * lineEdi
             continue;
         if (g_assemblyGraph->m_trinityGraph)
             nodeNumber = getFullTrinityNodeNumberFromName(nodesList.at(i));
+        else if (g_assemblyGraph->hasSegmentNames())
+            nodeNumber = g_assemblyGraph->getNodeNumberFromSegmentName(nodesList.at(i));
         else
             nodeNumber = nodesList.at(i).toLongLong();
-        if (g_assemblyGraph->m_deBruijnGraphNodes.contains(nodeNumber))
-            returnVector.push_back(g_assemblyGraph->m_deBruijnGraphNodes[nodeNumber]);
+        DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.value(nodeNumber, 0);
+        if (node != 0)
+            returnVector.push_back(node);
         else if (nodesNotInGraph != 0)
             nodesNotInGraph->push_back(nodesList.at(i).trimmed());
     }
@@ -1116,7 +857,7 @@ void MainWindow::layoutGraph()
                                                                   g_settings->graphLayoutQuality, g_settings->segmentLength);
     graphLayoutWorker->moveToThread(m_layoutThread);
 
-    connect(progress, SIGNAL(haltLayout()), this, SLOT(graphLayoutCancelled()));
+    connect(progress, SIGNAL(halt()), this, SLOT(graphLayoutCancelled()));
     connect(m_layoutThread, SIGNAL(started()), graphLayoutWorker, SLOT(layoutGraph()));
     connect(graphLayoutWorker, SIGNAL(finishedLayout()), m_layoutThread, SLOT(quit()));
     connect(graphLayoutWorker, SIGNAL(finishedLayout()), graphLayoutWorker, SLOT(deleteLater()));
@@ -1136,13 +877,11 @@ void MainWindow::addGraphicsItemsToScene()
     double meanDrawnCoverage = g_assemblyGraph->getMeanDeBruijnGraphCoverage(true);
 
     //First make the GraphicsItemNode objects
-    QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (i.hasNext())
+    for (int i = 0; i < g_assemblyGraph->m_deBruijnGraphNodes.size(); ++i)
     {
-        i.next();
-        if (i.value()->m_drawn)
+        DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.at(i);
+        if (node->m_drawn)
         {
-            DeBruijnNode * node = i.value();
             if (meanDrawnCoverage == 0)
                 node->m_coverageRelativeToMeanDrawnCoverage = 1.0;
             else
@@ -1171,11 +910,9 @@ void MainWindow::addGraphicsItemsToScene()
 
     //Now add the GraphicsItemNode objects to the scene so they are drawn
     //on top
-    QMapIterator<long long, DeBruijnNode*> j(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (j.hasNext())
+    for (int j = 0; j < g_assemblyGraph->m_deBruijnGraphNodes.size(); ++j)
     {
-        j.next();
-        DeBruijnNode * node = j.value();
+        DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.at(j);
         if (node->hasGraphicsItem())
             m_scene->addItem(node->m_graphicsItemNode);
     }
@@ -1275,7 +1012,7 @@ void MainWindow::copySelectedSequencesToClipboard()
 
     for (size_t i = 0; i < selectedNodes.size(); ++i)
     {
-        clipboardText += selectedNodes[i]->m_sequence;
+        clipboardText += selectedNodes[i]->getSequence();
         if (i != selectedNodes.size() - 1)
             clipboardText += "\n";
     }
@@ -1468,7 +1205,7 @@ void MainWindow::setNodeCustomColour()
     if (selectedNodes.size() > 1)
         dialogTitle += "s";
 
-    QColor newColour = QColorDialog::getColor(selectedNodes[0]->m_customColour, this, dialogTitle);
+    QColor newColour = QColorDialog::getColor(g_assemblyGraph->getNodeCustomColour(selectedNodes[0]), this, dialogTitle);
     if (newColour.isValid())
     {
         //If the colouring scheme is not currently custom, change it to custom now
@@ -1477,7 +1214,7 @@ void MainWindow::setNodeCustomColour()
 
         for (size_t i = 0; i < selectedNodes.size(); ++i)
         {
-            selectedNodes[i]->m_customColour = newColour;
+            g_assemblyGraph->setNodeCustomColour(selectedNodes[i], newColour);
             if (selectedNodes[i]->m_graphicsItemNode != 0)
                 selectedNodes[i]->m_graphicsItemNode->setNodeColour();
 
@@ -1499,7 +1236,7 @@ void MainWindow::setNodeCustomLabel()
 
     bool ok;
     QString newLabel = QInputDialog::getText(this, "Custom label", dialogMessage, QLineEdit::Normal,
-                                             selectedNodes[0]->m_customLabel, &ok);
+                                             g_assemblyGraph->getNodeCustomLabel(selectedNodes[0]), &ok);
 
     if (ok)
     {
@@ -1507,7 +1244,7 @@ void MainWindow::setNodeCustomLabel()
         ui->nodeCustomLabelsCheckBox->setChecked(true);
 
         for (size_t i = 0; i < selectedNodes.size(); ++i)
-            selectedNodes[i]->m_customLabel = newLabel;
+            g_assemblyGraph->setNodeCustomLabel(selectedNodes[i], newLabel);
     }
 }
 
@@ -1538,9 +1275,11 @@ void MainWindow::removeNodes()
 
 void MainWindow::removeAllGraphicsEdgesFromNode(DeBruijnNode * node)
 {
-    for (size_t i = 0; i < node->m_edges.size(); ++i)
+    //A loop is in both of the node's edge ranges, but its graphics item is
+    //only removed the first time.
+    for (DeBruijnEdge * const * i = node->outEdgesBegin(); i != node->inEdgesEnd(); ++i)
     {
-        DeBruijnEdge * deBruijnEdge = node->m_edges[i];
+        DeBruijnEdge * deBruijnEdge = *i;
         GraphicsItemEdge * graphicsItemEdge = deBruijnEdge->m_graphicsItemEdge;
         if (graphicsItemEdge != 0)
         {
@@ -1567,13 +1306,12 @@ void MainWindow::openSettingsDialog()
         //If the contig width was changed, reset the width on each GraphicsItemNode.
         if (settingsBefore.averageNodeWidth != g_settings->averageNodeWidth ||
                 settingsBefore.coverageEffectOnWidth != g_settings->coverageEffectOnWidth ||
-                settingsBefore.coveragePower != g_settings->coveragePower)
+                settingsBefore.coveragePower != g_settings->coveragePower ||
+                settingsBefore.widthCoveragePercentileCap != g_settings->widthCoveragePercentileCap)
         {
-            QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-            while (i.hasNext())
+            for (int i = 0; i < g_assemblyGraph->m_deBruijnGraphNodes.size(); ++i)
             {
-                i.next();
-                GraphicsItemNode * graphicsItemNode = i.value()->m_graphicsItemNode;
+                GraphicsItemNode * graphicsItemNode = g_assemblyGraph->m_deBruijnGraphNodes.at(i)->m_graphicsItemNode;
                 if (graphicsItemNode != 0)
                     graphicsItemNode->setWidth();
             }
@@ -1587,6 +1325,9 @@ void MainWindow::openSettingsDialog()
                 settingsBefore.highCoverageColour != g_settings->highCoverageColour ||
                 settingsBefore.lowCoverageValue != g_settings->lowCoverageValue ||
                 settingsBefore.highCoverageValue != g_settings->highCoverageValue ||
+                settingsBefore.autoCoverageValue != g_settings->autoCoverageValue ||
+                settingsBefore.lowCoveragePercentile != g_settings->lowCoveragePercentile ||
+                settingsBefore.highCoveragePercentile != g_settings->highCoveragePercentile ||
                 settingsBefore.noBlastHitsColour != g_settings->noBlastHitsColour ||
                 settingsBefore.contiguousStrandSpecificColour != g_settings->contiguousStrandSpecificColour ||
                 settingsBefore.contiguousEitherStrandColour != g_settings->contiguousEitherStrandColour ||
@@ -1710,6 +1451,13 @@ void MainWindow::openAboutDialog()
 }
 
 
+void MainWindow::openHistogramDialog()
+{
+    HistogramDialog histogramDialog(this);
+    histogramDialog.exec();
+}
+
+
 void MainWindow::openBlastSearchDialog()
 {
     BlastSearchDialog blastSearchDialog(this);
@@ -1747,7 +1495,7 @@ void MainWindow::blastTargetChanged()
     {
         BlastHit * hit = &(g_blastSearch->m_hits[i]);
         if (hit->m_query == currentQuery)
-            hit->m_node->m_blastHits.push_back(hit);
+            g_assemblyGraph->addNodeBlastHit(hit->m_node, hit);
     }
 
     g_graphicsView->viewport()->update();
@@ -1759,16 +1507,16 @@ void MainWindow::saveAllNodesToFasta(QString path, bool includeEmptyNodes, bool
 {
     QFile file(path + "all_nodes.fasta");
     file.open(QIODevice::WriteOnly | QIODevice::Text);
-    QTextStream out(&file);
 
-    QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (i.hasNext())
+    //The FASTA is already bytes, so it is written straight to the file
+    //instead of going through a QTextStream's text encoding.
+    for (int i = 0; i < g_assemblyGraph->m_deBruijnGraphNodes.size(); ++i)
     {
-        i.next();
-        if (includeEmptyNodes || i.value()->m_length > 0)
+        DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.at(i);
+        if (includeEmptyNodes || node->m_length > 0)
         {
-            out << i.value()->getFasta(useTrinityNames);
-            out << "\n";
+            file.write(node->getFasta(useTrinityNames));
+            file.write("\n");
         }
     }
     file.close();
@@ -1788,18 +1536,29 @@ void MainWindow::setInfoTexts()
 
     ui->graphInformationInfoText->setInfoText("Node codes, edge count and total length are calculated using single "
                                               "nodes, not double nodes.<br><br>"
-                                              "For example, node 5 and node -5 are counted only once.");
+                                              "For example, node 5 and node -5 are counted only once.<br><br>"
+                                              "N50 is the length of the node at which the longest nodes make up half of "
+                                              "the total length, and L50 is the number of those nodes. N90 is the same "
+                                              "for 90% of the total length.<br><br>"
+                                              "The median coverage is length-weighted, so it is the coverage "
+                                              "of the median base, not of the median node.<br><br>"
+                                              "The GC content is not available when sequences are loaded on demand.");
     ui->graphScopeInfoText->setInfoText("This controls how much of the assembly graph will be drawn:<ul>"
                                         "<li>'Entire graph': all nodes in the graph will be drawn. This is "
                                         "appropriate for smaller graphs, but large graphs may take "
                                         "longer and use large amounts of memory to draw in their entirety.</li>"
                                         "<li>'Around nodes': you can specify nodes and a distance to "
                                         "limit the drawing to a smaller region of the graph.</li>"
+                                        "<li>'Around nodes (bp)': the same as 'Around nodes', but the "
+                                        "distance is measured in base pairs instead of steps.</li>"
                                         "<li>'Around BLAST hits': if you have conducted a BLAST search "
                                         "on this graph, this option will draw the region(s) of the graph "
                                         "around nodes that contain hits.</li></ul>");
     ui->startingNodesInfoText->setInfoText("Enter a comma-delimited list of node numbers here. This will "
-                                           "define which regions of the graph will be drawn.");
+                                           "define which regions of the graph will be drawn.<br><br>"
+                                           "If the graph is a GFA file whose segments have names instead of "
+                                           "numbers, enter the segment names, with a '-' on the end for the "
+                                           "opposite strand.");
     ui->nodeStyleInfoText->setInfoText("'Single' mode will only draw nodes with positive numbers, not their "
                                        "complement nodes with negative numbers. This produces a simpler graph visualisation, but "
                                        "strand-specific sequences and directionality will be less clear.<br><br>"
@@ -1899,6 +1658,7 @@ void MainWindow::enableDisableUiElements(UiState uiState)
         ui->actionSave_selected_node_sequences_to_FASTA->setEnabled(false);
         ui->actionBring_selected_nodes_to_front->setEnabled(false);
         ui->actionZoom_to_selection->setEnabled(false);
+        ui->actionHistograms->setEnabled(false);
         break;
     case GRAPH_LOADED:
         ui->graphDetailsWidget->setEnabled(true);
@@ -1920,6 +1680,7 @@ void MainWindow::enableDisableUiElements(UiState uiState)
         ui->actionSave_selected_node_sequences_to_FASTA->setEnabled(false);
         ui->actionBring_selected_nodes_to_front->setEnabled(false);
         ui->actionZoom_to_selection->setEnabled(false);
+        ui->actionHistograms->setEnabled(true);
         break;
     case GRAPH_DRAWN:
         ui->graphDetailsWidget->setEnabled(true);
@@ -1941,6 +1702,7 @@ void MainWindow::enableDisableUiElements(UiState uiState)
         ui->actionSave_selected_node_sequences_to_FASTA->setEnabled(true);
         ui->actionBring_selected_nodes_to_front->setEnabled(true);
         ui->actionZoom_to_selection->setEnabled(true);
+        ui->actionHistograms->setEnabled(true);
         break;
     }
 }
@@ -1984,11 +1746,9 @@ void MainWindow::selectNodesWithBlastHits()
     m_scene->clearSelection();
 
     bool atLeastOneNodeSelected = false;
-    QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (i.hasNext())
+    for (int i = 0; i < g_assemblyGraph->m_deBruijnGraphNodes.size(); ++i)
     {
-        i.next();
-        DeBruijnNode * node = i.value();
+        DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.at(i);
         GraphicsItemNode * graphicsItemNode = node->m_graphicsItemNode;
 
         if (graphicsItemNode == 0)
@@ -1997,7 +1757,7 @@ void MainWindow::selectNodesWithBlastHits()
         //If we're in double mode, only select a node if it has a BLAST hit itself.
         if (g_settings->doubleMode)
         {
-            if (node->m_blastHits.size() > 0)
+            if (node->thisNodeHasBlastHits())
             {
                 graphicsItemNode->setSelected(true);
                 atLeastOneNodeSelected = true;
@@ -2007,7 +1767,7 @@ void MainWindow::selectNodesWithBlastHits()
         //In single mode, select a node if it or its reverse complement has a BLAST hit.
         else
         {
-            if (node->m_blastHits.size() > 0 || node->m_reverseComplement->m_blastHits.size() > 0)
+            if (node->thisNodeOrReverseComplementHasBlastHits())
             {
                 graphicsItemNode->setSelected(true);
                 atLeastOneNodeSelected = true;
@@ -2120,11 +1880,9 @@ void MainWindow::selectBasedOnContiguity(ContiguityStatus targetContiguityStatus
     m_scene->blockSignals(true);
     m_scene->clearSelection();
 
-    QMapIterator<long long, DeBruijnNode*> i(g_assemblyGraph->m_deBruijnGraphNodes);
-    while (i.hasNext())
+    for (int i = 0; i < g_assemblyGraph->m_deBruijnGraphNodes.size(); ++i)
     {
-        i.next();
-        DeBruijnNode * node = i.value();
+        DeBruijnNode * node = g_assemblyGraph->m_deBruijnGraphNodes.at(i);
         GraphicsItemNode * graphicsItemNode = node->m_graphicsItemNode;
 
         if (graphicsItemNode == 0)
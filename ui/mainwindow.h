@@ -33,6 +33,7 @@
 class GraphicsViewZoom;
 class MyGraphicsScene;
 class DeBruijnNode;
+class GraphLoadWorker;
 
 namespace Ui {
 class MainWindow;
@@ -53,6 +54,8 @@ private:
     GraphicsViewZoom * m_graphicsViewZoom;
     double m_previousZoomSpinBoxValue;
     QThread * m_layoutThread;
+    QThread * m_loadThread;
+    GraphLoadWorker * m_graphLoadWorker;
     ogdf::FMMMLayout * m_fmmm;
 
     void cleanUp();
@@ -65,7 +68,8 @@ private:
     void zoomToFitScene();
     void setZoomSpinBoxStep();
     void removeAllGraphicsEdgesFromNode(DeBruijnNode * node);
-    void getSelectedNodeInfo(int & selectedNodeCount, QString & selectedNodeCountText, QString & selectedNodeListText, QString & selectedNodeLengthText);
+    void getSelectedNodeInfo(int & selectedNodeCount, QString & selectedNodeCountText, QString & selectedNodeListText, QString & selectedNodeLengthText,
+                             QString & selectedNodeReadCountText);
     QString getSelectedEdgeListText();
     double getGraphicsItemNodeWidth(double coverageRelativeToMean);
     std::vector<DeBruijnNode *> getNodesFromLineEdit(QLineEdit * lineEdit, std::vector<QString> * nodesNotInGraph = 0);
@@ -75,23 +79,20 @@ private:
     bool checkFileIsLastGraph(QString fullFileName);
     bool checkFileIsFastG(QString fullFileName);
     bool checkFileIsTrinityFasta(QString fullFileName);
-    bool checkFirstLineOfFile(QString fullFileName, QString regExp);
+    bool checkFileIsGfa(QString fullFileName);
+    bool checkFirstLineOfFile(QString fullFileName, QString regExp, bool skipComments = false);
     void loadGraphFile1(QString graphFileType);
     void loadGraphFile2(QString graphFileType, QString filename);
-    void buildDeBruijnGraphFromLastGraph(QString fullFileName);
-    void buildDeBruijnGraphFromFastg(QString fullFileName);
-    void buildDeBruijnGraphFromTrinityFasta(QString fullFileName);
     void buildOgdfGraphFromNodesAndEdges();
     void setInfoTexts();
     void enableDisableUiElements(UiState uiState);
-    void makeReverseComplementNodeIfNecessary(DeBruijnNode * node);
-    void pointEachNodeToItsReverseComplement();
     void selectBasedOnContiguity(ContiguityStatus contiguityStatus);
 
 private slots:
     void loadLastGraph();
     void loadFastg();
     void loadTrinityFasta();
+    void loadGfa();
     void selectionChanged();
     void graphScopeChanged();
     void drawGraph();
@@ -110,8 +111,10 @@ private slots:
     void removeNodes();
     void openSettingsDialog();
     void openAboutDialog();
+    void openHistogramDialog();
     void selectUserSpecifiedNodes();
     void graphLayoutFinished();
+    void graphLoadFinished();
     void openBlastSearchDialog();
     void blastTargetChanged();
     void saveAllNodesToFasta(QString path, bool includeEmptyNodes, bool useTrinityNames);
@@ -22,7 +22,7 @@
 
 MyProgressDialog::MyProgressDialog(QWidget * parent, QString message, bool showCancelButton) :
     QDialog(parent),
-    ui(new Ui::MyProgressDialog)
+    ui(new Ui::MyProgressDialog), m_cancellingMessage("Cancelling layout...")
 {
     setWindowFlags(Qt::Dialog | Qt::FramelessWindowHint);
 
@@ -49,7 +49,7 @@ MyProgressDialog::MyProgressDialog(QWidget * parent, QString message, bool showC
                                     "result in shorter contigs which take less time to lay out.</li>"
                                     "<li>Reduce the 'Graph layout iterations' setting.</li></ul>");
 
-    connect(ui->cancelButton, SIGNAL(clicked()), this, SLOT(cancelLayout()));
+    connect(ui->cancelButton, SIGNAL(clicked()), this, SLOT(cancel()));
 }
 
 MyProgressDialog::~MyProgressDialog()
@@ -58,9 +58,33 @@ MyProgressDialog::~MyProgressDialog()
 }
 
 
-void MyProgressDialog::cancelLayout()
+//The dialog's cancel button is set up for graph layout by default.  This
+//function changes it for use with other tasks.
+void MyProgressDialog::setCancelButton(QString buttonText, QString cancellingMessage, QString infoText)
 {
-    ui->messageLabel->setText("Cancelling layout...");
+    ui->cancelButton->setText(buttonText);
+    ui->cancelInfoText->setInfoText(infoText);
+    m_cancellingMessage = cancellingMessage;
+}
+
+
+//By default, the progress bar has no maximum and just shows that Bandage is
+//busy.  Setting a maximum makes it show how much of the task is complete.
+void MyProgressDialog::setMaxValue(int max)
+{
+    ui->progressBar->setMaximum(max);
+}
+
+
+void MyProgressDialog::setValue(int value)
+{
+    ui->progressBar->setValue(value);
+}
+
+
+void MyProgressDialog::cancel()
+{
+    ui->messageLabel->setText(m_cancellingMessage);
     ui->cancelButton->setEnabled(false);
-    emit haltLayout();
+    emit halt();
 }
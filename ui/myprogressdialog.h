@@ -33,14 +33,21 @@ public:
     explicit MyProgressDialog(QWidget * parent, QString message, bool showCancelButton);
     ~MyProgressDialog();
 
+    void setCancelButton(QString buttonText, QString cancellingMessage, QString infoText);
+    void setMaxValue(int max);
+
 private:
     Ui::MyProgressDialog *ui;
+    QString m_cancellingMessage;
+
+public slots:
+    void setValue(int value);
 
 private slots:
-    void cancelLayout();
+    void cancel();
 
 signals:
-    void haltLayout();
+    void halt();
 };
 
 #endif // MYPROGRESSDIALOG_H
@@ -113,6 +113,7 @@ void SettingsDialog::loadOrSaveSettingsToOrFromWidgets(bool setWidgets, Settings
     doubleFunctionPointer(&settings->averageNodeWidth, ui->averageNodeWidthSpinBox, false);
     doubleFunctionPointer(&settings->coverageEffectOnWidth, ui->coverageEffectOnWidthSpinBox, true);
     doubleFunctionPointer(&settings->coveragePower, ui->coveragePowerSpinBox, false);
+    intFunctionPointer(&settings->widthCoveragePercentileCap, ui->widthCoveragePercentileCapSpinBox);
     doubleFunctionPointer(&settings->edgeWidth, ui->edgeWidthSpinBox, false);
     doubleFunctionPointer(&settings->outlineThickness, ui->outlineThicknessSpinBox, false);
     doubleFunctionPointer(&settings->textOutlineThickness, ui->textOutlineThicknessSpinBox, false);
@@ -127,6 +128,8 @@ void SettingsDialog::loadOrSaveSettingsToOrFromWidgets(bool setWidgets, Settings
     colourFunctionPointer(&settings->highCoverageColour, &m_highCoverageColour);
     doubleFunctionPointer(&settings->lowCoverageValue, ui->lowCoverageValueSpinBox, false);
     doubleFunctionPointer(&settings->highCoverageValue, ui->highCoverageValueSpinBox, false);
+    intFunctionPointer(&settings->lowCoveragePercentile, ui->lowCoveragePercentileSpinBox);
+    intFunctionPointer(&settings->highCoveragePercentile, ui->highCoveragePercentileSpinBox);
     colourFunctionPointer(&settings->noBlastHitsColour, &m_noBlastHitsColour);
     intFunctionPointer(&settings->contiguitySearchSteps, ui->contiguitySearchDepthSpinBox);
     colourFunctionPointer(&settings->contiguousStrandSpecificColour, &m_contiguousStrandSpecificColour);
@@ -149,6 +152,10 @@ void SettingsDialog::loadOrSaveSettingsToOrFromWidgets(bool setWidgets, Settings
         ui->basePairsPerSegmentAutoLabel->setText(QString::number(settings->autoBasePairsPerSegment));
         ui->basePairsPerSegmentAutoRadioButton->setChecked(settings->nodeLengthMode == AUTO_NODE_LENGTH);
         ui->basePairsPerSegmentManualRadioButton->setChecked(settings->nodeLengthMode != AUTO_NODE_LENGTH);
+        ui->readTrackingSkipRadioButton->setChecked(settings->readTrackingMode == SKIP_READ_TRACKING);
+        ui->readTrackingLoadRadioButton->setChecked(settings->readTrackingMode != SKIP_READ_TRACKING);
+        ui->sequenceLoadingLoadRadioButton->setChecked(settings->sequenceLoadingMode == LOAD_SEQUENCES);
+        ui->sequenceLoadingOnDemandRadioButton->setChecked(settings->sequenceLoadingMode != LOAD_SEQUENCES);
     }
     else
     {
@@ -160,6 +167,14 @@ void SettingsDialog::loadOrSaveSettingsToOrFromWidgets(bool setWidgets, Settings
             settings->nodeLengthMode = AUTO_NODE_LENGTH;
         else
             settings->nodeLengthMode = MANUAL_NODE_LENGTH;
+        if (ui->readTrackingLoadRadioButton->isChecked())
+            settings->readTrackingMode = LOAD_READ_TRACKING;
+        else
+            settings->readTrackingMode = SKIP_READ_TRACKING;
+        if (ui->sequenceLoadingOnDemandRadioButton->isChecked())
+            settings->sequenceLoadingMode = LOAD_SEQUENCES_ON_DEMAND;
+        else
+            settings->sequenceLoadingMode = LOAD_SEQUENCES;
     }
 }
 
@@ -393,9 +408,17 @@ void SettingsDialog::setInfoTexts()
                                                 "nodes with coverage above the high coverage value.<br><br>"
                                                 "Nodes with coverage between the low and high coverage values will get an "
                                                 "intermediate colour.");
-    ui->coverageValuesInfoText->setInfoText("When set to 'Auto', the low coverage value is set to the first quartile and the high "
-                                            "coverage value is set to the third quartile.<br><br>"
+    ui->coverageValuesInfoText->setInfoText("When set to 'Auto', the low and high coverage values are set to percentiles of "
+                                            "the nodes' coverages (by default the first and third quartiles).<br><br>"
                                             "When set to 'Manual', you can specify the values used for coverage colouring.");
+    ui->lowCoveragePercentileInfoText->setInfoText("When the coverage values are set to 'Auto', the low coverage value is the "
+                                                   "coverage at this percentile of the graph's nodes.");
+    ui->highCoveragePercentileInfoText->setInfoText("When the coverage values are set to 'Auto', the high coverage value is the "
+                                                    "coverage at this percentile of the graph's nodes.");
+    ui->widthCoveragePercentileCapInfoText->setInfoText("Nodes with a coverage above this percentile of the graph's nodes are "
+                                                        "drawn no wider than a node at this percentile, so a few very high "
+                                                        "coverage nodes don't dwarf the rest.<br><br>"
+                                                        "If set to 100, node widths are not limited.");
     ui->noBlastHitsColourInfoText->setInfoText("When Bandage is set to the 'Colour using BLAST hits' option, this colour is "
                                                "used for nodes that do not have any BLAST hits.  It is also used for any region "
                                                "of a node without BLAST hits, even if there are BLAST hits in other regions of "
@@ -422,6 +445,21 @@ void SettingsDialog::setInfoTexts()
                                                  "are not determined to be contiguous with the starting node(s).");
     ui->contiguityStartingColourInfoText->setInfoText("When a contiguity search is conducted, this is the colour given to the "
                                                       "starting node(s).");
+    ui->readTrackingInfoText->setInfoText("Velvet LastGraph files made with read tracking on contain the position of every "
+                                          "read in every node.  These sections are usually most of the file and are not "
+                                          "used for drawing the graph.<br><br>"
+                                          "When set to 'Skip', Bandage stops reading the file when it reaches them, which makes "
+                                          "loading much faster.  When set to 'Load', the read positions are kept in memory "
+                                          "in a compact form and the number of reads in the selected nodes is shown "
+                                          "below their length.");
+    ui->sequenceLoadingInfoText->setInfoText("When set to 'Load', the sequence of every node is kept in memory.<br><br>"
+                                             "When set to 'On demand', nodes only store where their sequence is in the "
+                                             "graph file, and sequences are read from the file when they are needed (e.g. "
+                                             "when copying sequences or building a BLAST database).  This uses much less "
+                                             "memory for large graphs, but the graph file must not be changed or moved "
+                                             "while it is loaded.  The graph's GC content isn't calculated in this mode, "
+                                             "as it would mean reading every sequence.  Gzipped and Trinity.fasta files "
+                                             "always have their sequences loaded.");
 }
 
 
@@ -433,6 +471,8 @@ void SettingsDialog::enableDisableCoverageValueSpinBoxes()
     ui->highCoverageValueLabel->setEnabled(enable);
     ui->lowCoverageValueSpinBox->setEnabled(enable);
     ui->highCoverageValueSpinBox->setEnabled(enable);
+    ui->lowCoveragePercentileSpinBox->setEnabled(!enable);
+    ui->highCoveragePercentileSpinBox->setEnabled(!enable);
 }
 
 
@@ -440,6 +480,8 @@ void SettingsDialog::accept()
 {
     if (ui->lowCoverageValueSpinBox->value() > ui->highCoverageValueSpinBox->value())
         QMessageBox::warning(this, "Coverage value error", "The low coverage value cannot be greater than the high coverage value.");
+    else if (ui->lowCoveragePercentileSpinBox->value() > ui->highCoveragePercentileSpinBox->value())
+        QMessageBox::warning(this, "Coverage percentile error", "The low coverage percentile cannot be greater than the high coverage percentile.");
     else
         QDialog::accept();
 }